@@ -25,8 +25,10 @@
 
 #ifdef ARDUINOHA_TEST
 #include "mocks/AUnitHelpers.h"
+#include "mocks/HeapMock.h"
 #include "mocks/PubSubClientMock.h"
 #include "utils/HADictionary.h"
+#include "utils/HAKeywords.h"
 #include "utils/HASerializer.h"
 #endif
 
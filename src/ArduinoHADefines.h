@@ -3,6 +3,24 @@
 // by calling Serial.begin([baudRate]) before initializing ArduinoHA.
 // #define ARDUINOHA_DEBUG
 
+// Shortens data topics in the discovery messages using the base topic ("~").
+// The base topic is used only if the device type has at least two data topics.
+// #define ARDUINOHA_BASE_TOPIC
+
+// Collects heap allocation statistics of the library operations (see HAMqtt::getAllocationStats).
+// It's available only in the host build (ARDUINOHA_TEST) - allocations are reported by the mocks (see mocks/HeapMock.h).
+// #define ARDUINOHA_ALLOCATION_STATS
+
+// Makes serializers use static storage, so the library doesn't use the heap after construction.
+// Use it together with the HAMqttStatic class.
+// The size of the static serializer can be changed using ARDUINOHA_STATIC_SERIALIZER_SIZE macro
+// (it needs to fit the largest device type that you use - 27 entries for HAHVAC).
+// #define ARDUINOHA_STATIC_MEMORY
+
+// Stores numbers (HANumeric) in 4 bytes instead of 16 bytes (32-bit boards).
+// In this mode the base value is limited to +/-536870911 and the precision to 3 digits.
+// #define ARDUINOHA_COMPACT_NUMERIC
+
 // These macros allow to exclude some parts of the library to save more resources.
 // #define EX_ARDUINOHA_BINARY_SENSOR
 // #define EX_ARDUINOHA_BUTTON
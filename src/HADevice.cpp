@@ -6,11 +6,15 @@
 
 #define HADEVICE_INIT \
     _ownsUniqueId(false), \
-    _serializer(new HASerializer(nullptr, 6)), \
+    _serializerStorage(nullptr, _serializerEntries, HADEVICE_SERIALIZER_SIZE), \
+    _serializer(&_serializerStorage), \
     _availabilityTopic(nullptr), \
     _sharedAvailability(false), \
     _available(true), \
-    _extendedUniqueIds(false)
+    _extendedUniqueIds(false), \
+    _serializerCache(false), \
+    _serializedSize(0), \
+    _serializedData(nullptr)
 
 HADevice::HADevice() :
     _uniqueId(nullptr),
@@ -36,8 +40,6 @@ HADevice::HADevice(const byte* uniqueId, const uint16_t length) :
 
 HADevice::~HADevice()
 {
-    delete _serializer;
-
     if (_availabilityTopic) {
         delete _availabilityTopic;
     }
@@ -45,6 +47,8 @@ HADevice::~HADevice()
     if (_ownsUniqueId) {
         delete[] _uniqueId;
     }
+
+    clearSerializerCache();
 }
 
 bool HADevice::setUniqueId(const byte* uniqueId, const uint16_t length)
@@ -55,39 +59,74 @@ bool HADevice::setUniqueId(const byte* uniqueId, const uint16_t length)
 
     _uniqueId = HAUtils::byteArrayToStr(uniqueId, length);
     _ownsUniqueId = true;
-    _serializer->set(AHATOFSTR(HADeviceIdentifiersProperty), _uniqueId);
+    setProperty(HADeviceIdentifiersProperty, _uniqueId);
     return true;
 }
 
 void HADevice::setManufacturer(const char* manufacturer)
 {
-    _serializer->set(AHATOFSTR(HADeviceManufacturerProperty), manufacturer);
+    setProperty(HADeviceManufacturerProperty, manufacturer);
 }
 
 void HADevice::setModel(const char* model)
 {
-    _serializer->set(AHATOFSTR(HADeviceModelProperty), model);
+    setProperty(HADeviceModelProperty, model);
 }
 
 void HADevice::setName(const char* name)
 {
-    _serializer->set(AHATOFSTR(HANameProperty), name);
+    setProperty(HANameProperty, name);
 }
 
 void HADevice::setSoftwareVersion(const char* softwareVersion)
 {
-    _serializer->set(
-        AHATOFSTR(HADeviceSoftwareVersionProperty),
-        softwareVersion
-    );
+    setProperty(HADeviceSoftwareVersionProperty, softwareVersion);
 }
 
 void HADevice::setConfigurationUrl(const char* url)
 {
-    _serializer->set(
-        AHATOFSTR(HADeviceConfigurationUrlProperty),
-        url
-    );
+    setProperty(HADeviceConfigurationUrlProperty, url);
+}
+
+uint16_t HADevice::calculateSerializedSize() const
+{
+    if (_serializedSize == 0) {
+        _serializedSize = _serializer->calculateSize();
+    }
+
+    return _serializedSize;
+}
+
+bool HADevice::flushSerializedData() const
+{
+    HAMqtt* mqtt = HAMqtt::instance();
+    if (!mqtt) {
+        return false;
+    }
+
+    // captures can't be nested, so the cache is built during the next flush
+    if (!_serializerCache || (!_serializedData && mqtt->isCapturingPayload())) {
+        return _serializer->flush();
+    }
+
+    if (!_serializedData) {
+        const uint16_t size = calculateSerializedSize();
+        char* data = new char[size];
+
+        mqtt->beginPayloadCapture(data, size);
+        const bool result = _serializer->flush();
+        const uint16_t length = mqtt->endPayloadCapture();
+
+        if (!result || length != size) {
+            delete[] data;
+            return false;
+        }
+
+        _serializedData = data;
+    }
+
+    mqtt->writePayload(_serializedData, _serializedSize);
+    return true;
 }
 
 void HADevice::setAvailability(bool online)
@@ -153,3 +192,19 @@ void HADevice::publishAvailability() const
         mqtt->endPublish();
     }
 }
+
+void HADevice::setProperty(const char* property, const char* value)
+{
+    _serializer->update(AHATOFSTR(property), value);
+    clearSerializerCache();
+}
+
+void HADevice::clearSerializerCache()
+{
+    _serializedSize = 0;
+
+    if (_serializedData) {
+        delete[] _serializedData;
+        _serializedData = nullptr;
+    }
+}
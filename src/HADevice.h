@@ -2,8 +2,11 @@
 #define AHA_HADEVICE_H
 
 #include <Arduino.h>
+#include "ArduinoHADefines.h"
+#include "utils/HASerializer.h"
 
-class HASerializer;
+/// The maximum number of entries in the device's serializer.
+#define HADEVICE_SERIALIZER_SIZE 6
 
 /**
  * This class represents your device that's going to be registered in the Home Assistant devices registry.
@@ -54,6 +57,27 @@ public:
     inline const HASerializer* getSerializer() const
         { return _serializer; }
 
+    /**
+     * Returns the size of the device's representation (JSON object).
+     * The size is calculated once and it's reused until one of the device's properties is set again.
+     * If you modify a string passed to one of the setters, you need to call the setter again.
+     */
+    uint16_t calculateSerializedSize() const;
+
+    /**
+     * Flushes the device's representation (JSON object) to the MQTT.
+     * The cached JSON is written if the cache was enabled using HADevice::enableSerializerCache method.
+     */
+    bool flushSerializedData() const;
+
+    /**
+     * Enables the cache of the device's representation (JSON object).
+     * The JSON is kept in RAM, so each entity's configuration reuses it instead of serializing the device again.
+     * The cache is rebuilt when one of the device's properties changes.
+     */
+    inline void enableSerializerCache()
+        { _serializerCache = true; }
+
     /**
      * Returns true if the shared availability is enabled for the device.
      */
@@ -164,7 +188,13 @@ private:
     /// Specifies whether HADevice class owns the _uniqueId pointer.
     bool _ownsUniqueId;
 
-    /// JSON serializer of the HADevice class. It's allocated in the constructor.
+    /// Storage for entries of the device's serializer.
+    HASerializer::SerializerEntry _serializerEntries[HADEVICE_SERIALIZER_SIZE];
+
+    /// JSON serializer of the HADevice class. It uses the `_serializerEntries` storage.
+    HASerializer _serializerStorage;
+
+    /// Pointer to the `_serializerStorage`.
     HASerializer* _serializer;
 
     /// The availability topic allocated by HADevice::enableSharedAvailability method.
@@ -178,6 +208,25 @@ private:
 
     /// Specifies whether extended unique IDs feature is enabled.
     bool _extendedUniqueIds;
+
+    /// Specifies whether the cache of the device's representation is enabled.
+    bool _serializerCache;
+
+    /// The cached size of the device's representation. It's zero if the size wasn't calculated yet.
+    mutable uint16_t _serializedSize;
+
+    /// The cached device's representation (without null terminator). It's nullptr if the cache is disabled or outdated.
+    mutable char* _serializedData;
+
+    /**
+     * Sets the given property in the serializer and invalidates the cache.
+     */
+    void setProperty(const char* property, const char* value);
+
+    /**
+     * Invalidates the cached representation of the device.
+     */
+    void clearSerializerCache();
 };
 
 #endif
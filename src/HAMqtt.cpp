@@ -7,13 +7,16 @@
 #include "HADevice.h"
 #include "device-types/HABaseDeviceType.h"
 #include "mocks/PubSubClientMock.h"
+#include "utils/HASerializer.h"
+#include "utils/HAUtils.h"
 
-#define HAMQTT_INIT \
+#define HAMQTT_INIT(devicesTypes, devicesTypesIndex) \
     _device(device), \
     _messageCallback(nullptr), \
     _connectedCallback(nullptr), \
     _disconnectedCallback(nullptr), \
     _stateChangedCallback(nullptr), \
+    _connectProgressCallback(nullptr), \
     _initialized(false), \
     _discoveryPrefix(DefaultDiscoveryPrefix), \
     _dataPrefix(DefaultDataPrefix), \
@@ -22,17 +25,106 @@
     _lastConnectionAttemptAt(0), \
     _devicesTypesNb(0), \
     _maxDevicesTypesNb(maxDevicesTypesNb), \
-    _devicesTypes(new HABaseDeviceType*[maxDevicesTypesNb]), \
+    _devicesTypes(devicesTypes), \
+    _devicesTypesIndex(devicesTypesIndex), \
+    _devicesTypesIndexNb(0), \
+    _ownsDevicesTypes(false), \
     _lastWillTopic(nullptr), \
     _lastWillMessage(nullptr), \
     _lastWillRetain(false), \
-    _currentState(StateDisconnected)
+    _currentState(StateDisconnected), \
+    _topicsCacheMode(TopicsCacheDisabled), \
+    _subscriptionMode(SubscriptionPerTopic), \
+    _discoveryPrefixLength(0), \
+    _dataPrefixLength(0), \
+    _connectBytesBudget(0), \
+    _connectTimeBudget(0), \
+    _connectPhaseIndex(0), \
+    _sentBytesNb(0), \
+    _configHashes(nullptr), \
+    _configHashLoadCallback(nullptr), \
+    _configHashSaveCallback(nullptr), \
+    _deviceDiscovery(false), \
+    _forceConfigPublish(false), \
+    _hashingPayload(false), \
+    _payloadHash(0), \
+    _captureBuffer(nullptr), \
+    _captureBufferSize(0), \
+    _captureLength(0), \
+    _stagingBuffer(nullptr), \
+    _stagingBufferSize(0), \
+    _stagedPayloadsNb(0), \
+    _streamedPayloadsNb(0), \
+    _largestStreamedPayloadSize(0), \
+    _writeBuffer(nullptr), \
+    _writeBufferSize(0), \
+    _writeBufferLength(0), \
+    _subscribeBuffer(nullptr), \
+    _subscribeBufferSize(0), \
+    _subscribeBufferLength(0), \
+    _batchingSubscriptions(false), \
+    _subscribePacketId(0)
 
 static const char* DefaultDiscoveryPrefix = "homeassistant";
 static const char* DefaultDataPrefix = "aha";
 
 HAMqtt* HAMqtt::_instance = nullptr;
 
+/**
+ * Compares the given unique ID (null terminated) with the string of the given length.
+ * The nullptr is considered to be lower than any other string.
+ */
+static int16_t compareUniqueIds(
+    const char* uniqueId,
+    const char* str,
+    const uint16_t length
+)
+{
+    if (!uniqueId || !str) {
+        return (uniqueId ? 1 : 0) - (str ? 1 : 0);
+    }
+
+    const int16_t result = strncmp(uniqueId, str, length);
+    if (result != 0) {
+        return result;
+    }
+
+    return uniqueId[length] == 0 ? 0 : 1;
+}
+
+#ifdef ARDUINOHA_ALLOCATION_STATS
+/**
+ * Assigns allocations to the given operation until the end of the scope.
+ * Nested scopes are attributed to the outer operation.
+ */
+class HAOperationScope
+{
+public:
+    HAOperationScope(HAMqtt::Operation& current, const HAMqtt::Operation operation) :
+        _current(current),
+        _previous(current)
+    {
+        if (_current == HAMqtt::OperationOther) {
+            _current = operation;
+        }
+    }
+
+    ~HAOperationScope()
+    {
+        _current = _previous;
+    }
+
+private:
+    HAMqtt::Operation& _current;
+    const HAMqtt::Operation _previous;
+};
+
+#define AHA_OPERATION_SCOPE(operation) \
+    HAOperationScope operationScope(_operation, operation);
+#else
+#define AHA_OPERATION_SCOPE(operation)
+#endif
+
 void onMessageReceived(char* topic, uint8_t* payload, unsigned int length)
 {
     if (HAMqtt::instance() == nullptr || length > UINT16_MAX) {
@@ -49,9 +141,26 @@ HAMqtt::HAMqtt(
     uint8_t maxDevicesTypesNb
 ) :
     _mqtt(pubSub),
-    HAMQTT_INIT
+    HAMQTT_INIT(
+        new HABaseDeviceType*[maxDevicesTypesNb],
+        new uint8_t[maxDevicesTypesNb]
+    )
 {
-    _instance = this;
+    _ownsDevicesTypes = true;
+    initialize();
+}
+
+HAMqtt::HAMqtt(
+    PubSubClientMock* pubSub,
+    HADevice& device,
+    HABaseDeviceType** devicesTypes,
+    uint8_t* devicesTypesIndex,
+    const uint8_t maxDevicesTypesNb
+) :
+    _mqtt(pubSub),
+    HAMQTT_INIT(devicesTypes, devicesTypesIndex)
+{
+    initialize();
 }
 #else
 HAMqtt::HAMqtt(
@@ -60,23 +169,67 @@ HAMqtt::HAMqtt(
     uint8_t maxDevicesTypesNb
 ) :
     _mqtt(new PubSubClient(netClient)),
-    HAMQTT_INIT
+    HAMQTT_INIT(
+        new HABaseDeviceType*[maxDevicesTypesNb],
+        new uint8_t[maxDevicesTypesNb]
+    )
 {
-    _instance = this;
+    _ownsDevicesTypes = true;
+    initialize();
+}
+
+HAMqtt::HAMqtt(
+    Client& netClient,
+    HADevice& device,
+    HABaseDeviceType** devicesTypes,
+    uint8_t* devicesTypesIndex,
+    const uint8_t maxDevicesTypesNb
+) :
+    _mqtt(new PubSubClient(netClient)),
+    HAMQTT_INIT(devicesTypes, devicesTypesIndex)
+{
+    initialize();
 }
 #endif
 
 HAMqtt::~HAMqtt()
 {
-    delete[] _devicesTypes;
+    if (_ownsDevicesTypes) {
+        delete[] _devicesTypes;
+        delete[] _devicesTypesIndex;
+    }
+
+    if (_configHashes) {
+        delete[] _configHashes;
+    }
+
+    if (_writeBuffer) {
+        delete[] _writeBuffer;
+    }
+
+    if (_subscribeBuffer) {
+        delete[] _subscribeBuffer;
+    }
 
     if (_mqtt) {
         delete _mqtt;
     }
 
+    HASerializer::releaseSharedStorage();
     _instance = nullptr;
 }
 
+void HAMqtt::initialize()
+{
+#ifdef ARDUINOHA_ALLOCATION_STATS
+    _operation = OperationOther;
+    _heapBytes = 0;
+    resetAllocationStats();
+#endif
+
+    _instance = this;
+}
+
 bool HAMqtt::begin(
     const IPAddress serverIp,
     const uint16_t serverPort,
@@ -105,6 +258,7 @@ bool HAMqtt::begin(
 
     _mqtt->setServer(serverIp, serverPort);
     _mqtt->setCallback(onMessageReceived);
+    cacheTopics();
 
     return true;
 }
@@ -146,6 +300,7 @@ bool HAMqtt::begin(
 
     _mqtt->setServer(serverHostname, serverPort);
     _mqtt->setCallback(onMessageReceived);
+    cacheTopics();
 
     return true;
 }
@@ -187,6 +342,8 @@ void HAMqtt::loop()
 
     if (!result) {
         connectToServer();
+    } else if (!isConnectPhaseFinished()) {
+        processConnectPhase();
     }
 }
 
@@ -205,6 +362,99 @@ bool HAMqtt::setBufferSize(uint16_t size)
     return _mqtt->setBufferSize(size);
 }
 
+void HAMqtt::enableWriteBuffer(const uint16_t size)
+{
+    if (_writeBuffer || size == 0) {
+        return;
+    }
+
+    _writeBuffer = new uint8_t[size];
+    _writeBufferSize = size;
+    _writeBufferLength = 0;
+}
+
+void HAMqtt::enableSubscriptionsBatching(const uint16_t size)
+{
+    if (_subscribeBuffer || size <= SubscribeHeaderSize) {
+        return;
+    }
+
+    _subscribeBuffer = new uint8_t[size];
+    _subscribeBufferSize = size;
+    _subscribeBufferLength = 0;
+}
+
+void HAMqtt::enableConfigCache()
+{
+    if (_configHashes) {
+        return;
+    }
+
+    // the last hash belongs to the device-level configuration
+    _configHashes = new uint32_t[_maxDevicesTypesNb + 1];
+    memset(_configHashes, 0, (_maxDevicesTypesNb + 1) * sizeof(uint32_t));
+}
+
+void HAMqtt::countStagedPayload(const uint16_t length)
+{
+    if (length <= _stagingBufferSize) {
+        _stagedPayloadsNb++;
+        return;
+    }
+
+    _streamedPayloadsNb++;
+
+    if (length > _largestStreamedPayloadSize) {
+        _largestStreamedPayloadSize = length;
+    }
+}
+
+void HAMqtt::republishConfigs()
+{
+    if (!isConnected()) {
+        return;
+    }
+
+    ARDUINOHA_DEBUG_PRINTLN(F("AHA: republishing configs"))
+
+    _forceConfigPublish = true;
+
+    if (_deviceDiscovery) {
+        publishDeviceConfig();
+    } else {
+        for (uint8_t i = 0; i < _devicesTypesNb; i++) {
+            _devicesTypes[i]->publishConfig();
+        }
+    }
+
+    _forceConfigPublish = false;
+}
+
+#ifdef ARDUINOHA_ALLOCATION_STATS
+void HAMqtt::resetAllocationStats()
+{
+    memset(_allocationStats, 0, sizeof(_allocationStats));
+}
+
+void HAMqtt::trackAllocation(const size_t size)
+{
+    HAAllocationStats& stats = _allocationStats[_operation];
+    stats.allocationsNb++;
+    stats.allocatedBytes += size;
+    _heapBytes += size;
+
+    if (_heapBytes > stats.peakHeapBytes) {
+        stats.peakHeapBytes = _heapBytes;
+    }
+}
+
+void HAMqtt::trackDeallocation(const size_t size)
+{
+    // blocks allocated before the instance was created aren't tracked
+    _heapBytes = size < _heapBytes ? _heapBytes - size : 0;
+}
+#endif
+
 void HAMqtt::addDeviceType(HABaseDeviceType* deviceType)
 {
     if (_devicesTypesNb + 1 > _maxDevicesTypesNb) {
@@ -212,6 +462,10 @@ void HAMqtt::addDeviceType(HABaseDeviceType* deviceType)
     }
 
     _devicesTypes[_devicesTypesNb++] = deviceType;
+
+    if (_initialized && _topicsCacheMode != TopicsCacheDisabled) {
+        deviceType->cacheTopics(_topicsCacheMode == TopicsCacheLengths);
+    }
 }
 
 bool HAMqtt::publish(const char* topic, const char* payload, bool retained)
@@ -225,6 +479,7 @@ bool HAMqtt::publish(const char* topic, const char* payload, bool retained)
     ARDUINOHA_DEBUG_PRINT(F(", len: "))
     ARDUINOHA_DEBUG_PRINTLN(strlen(payload))
 
+    _sentBytesNb += strlen(topic) + strlen(payload);
     _mqtt->beginPublish(topic, strlen(payload), retained);
     _mqtt->write((const uint8_t*)(payload), strlen(payload));
     return _mqtt->endPublish();
@@ -241,6 +496,8 @@ bool HAMqtt::beginPublish(
     ARDUINOHA_DEBUG_PRINT(F(", len: "))
     ARDUINOHA_DEBUG_PRINTLN(payloadLength)
 
+    _sentBytesNb += strlen(topic) + payloadLength;
+    _writeBufferLength = 0;
     return _mqtt->beginPublish(topic, payloadLength, retained);
 }
 
@@ -251,16 +508,308 @@ void HAMqtt::writePayload(const char* data, const uint16_t length)
 
 void HAMqtt::writePayload(const uint8_t* data, const uint16_t length)
 {
+    if (_captureBuffer) {
+        capturePayload(data, length, false);
+        return;
+    }
+
+    if (_hashingPayload) {
+        _payloadHash = HAUtils::calculateHash(_payloadHash, data, length);
+        return;
+    }
+
+    if (_writeBuffer) {
+        bufferPayload(data, length, false);
+        return;
+    }
+
     _mqtt->write(data, length);
 }
 
 void HAMqtt::writePayload(const __FlashStringHelper* src)
 {
-    _mqtt->print(src);
+    if (_captureBuffer) {
+        capturePayload(
+            reinterpret_cast<const uint8_t*>(src),
+            strlen_P(AHAFROMFSTR(src)),
+            true
+        );
+        return;
+    }
+
+    if (_hashingPayload) {
+        _payloadHash = HAUtils::calculateHash(
+            _payloadHash,
+            reinterpret_cast<const uint8_t*>(src),
+            strlen_P(AHAFROMFSTR(src)),
+            true
+        );
+        return;
+    }
+
+    if (_writeBuffer) {
+        bufferPayload(
+            reinterpret_cast<const uint8_t*>(src),
+            strlen_P(AHAFROMFSTR(src)),
+            true
+        );
+        return;
+    }
+
+    // flash strings are copied in blocks to avoid writing them byte by byte
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src);
+    uint16_t length = strlen_P(AHAFROMFSTR(src));
+    uint8_t chunk[32];
+
+    while (length > 0) {
+        const uint16_t chunkLength = length < sizeof(chunk) ? length : sizeof(chunk);
+        memcpy_P(chunk, ptr, chunkLength);
+        _mqtt->write(chunk, chunkLength);
+
+        ptr += chunkLength;
+        length -= chunkLength;
+    }
+}
+
+void HAMqtt::beginPayloadHash(const char* topic)
+{
+    _hashingPayload = true;
+    _payloadHash = HAUtils::HashSeed;
+
+    if (topic) {
+        _payloadHash = HAUtils::calculateHash(
+            _payloadHash,
+            reinterpret_cast<const uint8_t*>(topic),
+            strlen(topic)
+        );
+    }
+}
+
+uint32_t HAMqtt::endPayloadHash()
+{
+    _hashingPayload = false;
+    return _payloadHash;
+}
+
+void HAMqtt::beginPayloadCapture(char* buffer, const uint16_t size)
+{
+    _captureBuffer = buffer;
+    _captureBufferSize = size;
+    _captureLength = 0;
+}
+
+uint16_t HAMqtt::endPayloadCapture()
+{
+    _captureBuffer = nullptr;
+    return _captureLength;
+}
+
+void HAMqtt::bufferPayload(
+    const uint8_t* data,
+    uint16_t length,
+    const bool isProgmemData
+)
+{
+    // large chunks of RAM data don't need to be copied
+    if (!isProgmemData && length >= _writeBufferSize) {
+        flushWriteBuffer();
+        _mqtt->write(data, length);
+        return;
+    }
+
+    while (length > 0) {
+        if (_writeBufferLength == _writeBufferSize) {
+            flushWriteBuffer();
+        }
+
+        const uint16_t available = _writeBufferSize - _writeBufferLength;
+        const uint16_t copyLength = length < available ? length : available;
+
+        if (isProgmemData) {
+            memcpy_P(&_writeBuffer[_writeBufferLength], data, copyLength);
+        } else {
+            memcpy(&_writeBuffer[_writeBufferLength], data, copyLength);
+        }
+
+        _writeBufferLength += copyLength;
+        data += copyLength;
+        length -= copyLength;
+    }
+}
+
+void HAMqtt::flushWriteBuffer()
+{
+    if (_writeBufferLength == 0) {
+        return;
+    }
+
+    _mqtt->write(_writeBuffer, _writeBufferLength);
+    _writeBufferLength = 0;
+}
+
+void HAMqtt::beginSubscriptionsBatch()
+{
+    _batchingSubscriptions = _subscribeBuffer != nullptr;
+}
+
+void HAMqtt::endSubscriptionsBatch()
+{
+    flushSubscriptions();
+    _batchingSubscriptions = false;
+}
+
+bool HAMqtt::flushSubscriptions()
+{
+    if (_subscribeBufferLength == 0) {
+        return true;
+    }
+
+    // identifiers wrap within the upper half of the range, so they don't collide with PubSubClient's ones
+    if (++_subscribePacketId < SubscribePacketIdBase) {
+        _subscribePacketId = SubscribePacketIdBase;
+    }
+
+    // the remaining length is encoded as variable byte integer right before the packet identifier
+    uint32_t remainingLength = _subscribeBufferLength - SubscribeHeaderSize + 2;
+    uint8_t encodedLength[4];
+    uint8_t encodedLengthSize = 0;
+
+    do {
+        uint8_t digit = remainingLength & 0x7F;
+        remainingLength >>= 7;
+        if (remainingLength > 0) {
+            digit |= 0x80;
+        }
+
+        encodedLength[encodedLengthSize++] = digit;
+    } while (remainingLength > 0);
+
+    const uint8_t start = SubscribeHeaderSize - 2 - encodedLengthSize - 1;
+    _subscribeBuffer[start] = SubscribePacketType;
+    memcpy(&_subscribeBuffer[start + 1], encodedLength, encodedLengthSize);
+    _subscribeBuffer[SubscribeHeaderSize - 2] = _subscribePacketId >> 8;
+    _subscribeBuffer[SubscribeHeaderSize - 1] = _subscribePacketId & 0xFF;
+
+    const uint16_t packetLength = _subscribeBufferLength - start;
+    _subscribeBufferLength = 0;
+
+    if (_mqtt->write(&_subscribeBuffer[start], packetLength) != packetLength) {
+        ARDUINOHA_DEBUG_PRINTLN(F("AHA: failed to send subscriptions"))
+        return false;
+    }
+
+    return true;
+}
+
+void HAMqtt::capturePayload(
+    const uint8_t* data,
+    const uint16_t length,
+    const bool isProgmemData
+)
+{
+    // data that doesn't fit is dropped but it's still counted
+    const uint16_t available = _captureLength < _captureBufferSize
+        ? _captureBufferSize - _captureLength
+        : 0;
+    const uint16_t copyLength = length < available ? length : available;
+
+    if (isProgmemData) {
+        memcpy_P(&_captureBuffer[_captureLength], data, copyLength);
+    } else {
+        memcpy(&_captureBuffer[_captureLength], data, copyLength);
+    }
+
+    _captureLength += length;
+}
+
+bool HAMqtt::isConfigPublished(
+    const HABaseDeviceType* deviceType,
+    const uint32_t hash
+)
+{
+    uint32_t* publishedHash = getConfigHash(deviceType);
+    if (!publishedHash || _forceConfigPublish || hash == 0) {
+        return false;
+    }
+
+    const char* uniqueId = deviceType ? deviceType->uniqueId() : _device.getUniqueId();
+    if (*publishedHash == 0 && _configHashLoadCallback && uniqueId) {
+        *publishedHash = _configHashLoadCallback(uniqueId);
+    }
+
+    return *publishedHash == hash;
+}
+
+void HAMqtt::setConfigPublished(
+    const HABaseDeviceType* deviceType,
+    const uint32_t hash
+)
+{
+    uint32_t* publishedHash = getConfigHash(deviceType);
+    if (!publishedHash || *publishedHash == hash) {
+        return;
+    }
+
+    *publishedHash = hash;
+
+    const char* uniqueId = deviceType ? deviceType->uniqueId() : _device.getUniqueId();
+    if (_configHashSaveCallback && uniqueId) {
+        _configHashSaveCallback(uniqueId, hash);
+    }
+}
+
+void HAMqtt::publishDeviceConfig()
+{
+    if (!_discoveryPrefix || !_device.getUniqueId()) {
+        return;
+    }
+
+    char topic[
+        getDiscoveryPrefixLength() + 1 + // prefix with slash
+        strlen_P(HAComponentDevice) + 1 + // component name with slash
+        strlen(_device.getUniqueId()) + 1 + // device ID with slash
+        strlen_P(HAConfigTopic) + 1 // including null terminator
+    ];
+    strcpy(topic, _discoveryPrefix);
+    strcat_P(topic, HASerializerSlash);
+    strcat_P(topic, HAComponentDevice);
+    strcat_P(topic, HASerializerSlash);
+    strcat(topic, _device.getUniqueId());
+    strcat_P(topic, HASerializerSlash);
+    strcat_P(topic, HAConfigTopic);
+
+    uint32_t hash = 0;
+    if (_configHashes) {
+        beginPayloadHash(topic);
+        const bool result = flushDeviceConfig();
+        hash = endPayloadHash();
+
+        if (!result) {
+            return;
+        }
+
+        if (isConfigPublished(nullptr, hash)) {
+            ARDUINOHA_DEBUG_PRINT(F("AHA: config didn't change "))
+            ARDUINOHA_DEBUG_PRINTLN(topic)
+            return;
+        }
+    }
+
+    const uint16_t size = calculateDeviceConfigSize();
+    if (size == 0 || !beginPublish(topic, size, true)) {
+        return;
+    }
+
+    flushDeviceConfig();
+
+    if (endPublish() && hash != 0) {
+        setConfigPublished(nullptr, hash);
+    }
 }
 
 bool HAMqtt::endPublish()
 {
+    flushWriteBuffer();
     return _mqtt->endPublish();
 }
 
@@ -269,11 +818,36 @@ bool HAMqtt::subscribe(const char* topic)
     ARDUINOHA_DEBUG_PRINT(F("AHA: subscribing "))
     ARDUINOHA_DEBUG_PRINTLN(topic)
 
-    return _mqtt->subscribe(topic);
+    const uint16_t topicLength = strlen(topic);
+    const uint16_t entrySize = topicLength + 3; // length prefix and requested QoS
+    _sentBytesNb += topicLength;
+
+    if (!_batchingSubscriptions || SubscribeHeaderSize + entrySize > _subscribeBufferSize) {
+        return _mqtt->subscribe(topic);
+    }
+
+    if (_subscribeBufferLength + entrySize > _subscribeBufferSize && !flushSubscriptions()) {
+        return false;
+    }
+
+    if (_subscribeBufferLength == 0) {
+        _subscribeBufferLength = SubscribeHeaderSize;
+    }
+
+    uint8_t* entry = &_subscribeBuffer[_subscribeBufferLength];
+    entry[0] = topicLength >> 8;
+    entry[1] = topicLength & 0xFF;
+    memcpy(&entry[2], topic, topicLength);
+    entry[entrySize - 1] = 0; // QoS 0
+
+    _subscribeBufferLength += entrySize;
+    return true;
 }
 
 void HAMqtt::processMessage(const char* topic, const uint8_t* payload, uint16_t length)
 {
+    AHA_OPERATION_SCOPE(OperationMessage)
+
     ARDUINOHA_DEBUG_PRINT(F("AHA: received call "))
     ARDUINOHA_DEBUG_PRINT(topic)
     ARDUINOHA_DEBUG_PRINT(F(", len: "))
@@ -283,11 +857,93 @@ void HAMqtt::processMessage(const char* topic, const uint8_t* payload, uint16_t
         _messageCallback(topic, payload, length);
     }
 
+    if (_configHashes && isBirthMessage(topic, payload, length)) {
+        republishConfigs();
+        return;
+    }
+
+    const char* objectId = nullptr;
+    const char* objectTopic = nullptr;
+    uint16_t objectIdLength = 0;
+
+    if (HASerializer::splitDataTopic(
+        topic,
+        &objectId,
+        &objectIdLength,
+        &objectTopic
+    )) {
+        HABaseDeviceType* deviceType = findDeviceType(objectId, objectIdLength);
+        if (deviceType) {
+            deviceType->onMqttMessage(topic, payload, length);
+        }
+
+        return;
+    }
+
     for (uint8_t i = 0; i < _devicesTypesNb; i++) {
         _devicesTypes[i]->onMqttMessage(topic, payload, length);
     }
 }
 
+void HAMqtt::buildDevicesTypesIndex()
+{
+    // insertion sort keeps the index ordered by the unique IDs
+    for (uint8_t i = 0; i < _devicesTypesNb; i++) {
+        const char* uniqueId = _devicesTypes[i]->uniqueId();
+        const uint16_t uniqueIdLength = uniqueId ? strlen(uniqueId) : 0;
+        uint8_t position = i;
+
+        while (
+            position > 0 &&
+            compareUniqueIds(
+                _devicesTypes[_devicesTypesIndex[position - 1]]->uniqueId(),
+                uniqueId,
+                uniqueIdLength
+            ) > 0
+        ) {
+            _devicesTypesIndex[position] = _devicesTypesIndex[position - 1];
+            position--;
+        }
+
+        _devicesTypesIndex[position] = i;
+    }
+
+    _devicesTypesIndexNb = _devicesTypesNb;
+}
+
+HABaseDeviceType* HAMqtt::findDeviceType(
+    const char* uniqueId,
+    const uint16_t length
+)
+{
+    if (_devicesTypesIndexNb != _devicesTypesNb) {
+        buildDevicesTypesIndex();
+    }
+
+    uint8_t low = 0;
+    uint8_t high = _devicesTypesNb;
+
+    while (low < high) {
+        const uint8_t middle = low + (high - low) / 2;
+        HABaseDeviceType* deviceType = _devicesTypes[_devicesTypesIndex[middle]];
+        const int16_t result = compareUniqueIds(
+            deviceType->uniqueId(),
+            uniqueId,
+            length
+        );
+
+        if (result == 0) {
+            return deviceType;
+        } else if (result < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return nullptr;
+}
+
 void HAMqtt::connectToServer()
 {
     if (_lastConnectionAttemptAt > 0 &&
@@ -321,15 +977,61 @@ void HAMqtt::connectToServer()
 
 void HAMqtt::onConnectedLogic()
 {
+    AHA_OPERATION_SCOPE(OperationConnect)
+
+    // the broker doesn't keep subscriptions of the previous session (clean session)
+    for (uint8_t i = 0; i < _devicesTypesNb; i++) {
+        _devicesTypes[i]->_subscribedCommands = 0;
+    }
+
+    beginSubscriptionsBatch();
+
     if (_connectedCallback) {
         _connectedCallback();
     }
 
     _device.publishAvailability();
 
-    for (uint8_t i = 0; i < _devicesTypesNb; i++) {
-        _devicesTypes[i]->onMqttConnected();
+    if (_configHashes) {
+        subscribeBirthTopic();
+    }
+
+    if (_subscriptionMode == SubscriptionPerDevice) {
+        subscribeDeviceWildcard();
     }
+
+    if (_deviceDiscovery) {
+        publishDeviceConfig();
+    }
+
+    _connectPhaseIndex = 0;
+    processConnectPhase();
+}
+
+void HAMqtt::processConnectPhase()
+{
+    AHA_OPERATION_SCOPE(OperationConnect)
+
+    const uint32_t startedAt = millis();
+    const uint32_t sentBytesNb = _sentBytesNb;
+    beginSubscriptionsBatch();
+
+    while (_connectPhaseIndex < _devicesTypesNb) {
+        _devicesTypes[_connectPhaseIndex++]->onMqttConnected();
+
+        if (_connectProgressCallback) {
+            _connectProgressCallback(_connectPhaseIndex, _devicesTypesNb);
+        }
+
+        if (
+            (_connectBytesBudget > 0 && _sentBytesNb - sentBytesNb >= _connectBytesBudget) ||
+            (_connectTimeBudget > 0 && millis() - startedAt >= _connectTimeBudget)
+        ) {
+            break;
+        }
+    }
+
+    endSubscriptionsBatch();
 }
 
 void HAMqtt::setState(ConnectionState state)
@@ -356,4 +1058,222 @@ void HAMqtt::setState(ConnectionState state)
     if (_stateChangedCallback) {
         _stateChangedCallback(_currentState);
     }
-}
\ No newline at end of file
+}
+
+void HAMqtt::cacheTopics()
+{
+    if (
+        _topicsCacheMode == TopicsCacheDisabled ||
+        !_discoveryPrefix ||
+        !_dataPrefix
+    ) {
+        return;
+    }
+
+    _discoveryPrefixLength = strlen(_discoveryPrefix);
+    _dataPrefixLength = strlen(_dataPrefix);
+
+    for (uint8_t i = 0; i < _devicesTypesNb; i++) {
+        _devicesTypes[i]->cacheTopics(_topicsCacheMode == TopicsCacheLengths);
+    }
+}
+
+uint32_t* HAMqtt::getConfigHash(const HABaseDeviceType* deviceType) const
+{
+    if (!_configHashes) {
+        return nullptr;
+    }
+
+    if (!deviceType) {
+        return &_configHashes[_maxDevicesTypesNb];
+    }
+
+    for (uint8_t i = 0; i < _devicesTypesNb; i++) {
+        if (_devicesTypes[i] == deviceType) {
+            return &_configHashes[i];
+        }
+    }
+
+    return nullptr;
+}
+
+uint16_t HAMqtt::calculateDeviceConfigSize()
+{
+    if (!_device.getSerializer()) {
+        return 0;
+    }
+
+    const uint16_t propertySize =
+        strlen_P(HASerializerJsonPropertyPrefix) +
+        strlen_P(HASerializerJsonPropertySuffix);
+    const uint16_t separatorSize = strlen_P(HASerializerJsonPropertiesSeparator);
+    const uint16_t objectSize =
+        strlen_P(HASerializerJsonDataPrefix) +
+        strlen_P(HASerializerJsonDataSuffix);
+
+    uint16_t size =
+        objectSize +
+        // device
+        propertySize + strlen_P(HADeviceProperty) +
+        _device.calculateSerializedSize() +
+        // origin
+        separatorSize +
+        propertySize + strlen_P(HAOriginProperty) +
+        objectSize +
+        propertySize + strlen_P(HANameProperty) +
+        2 * strlen_P(HASerializerJsonEscapeChar) + strlen_P(HAOriginName) +
+        // components
+        separatorSize +
+        propertySize + strlen_P(HAComponentsProperty) +
+        objectSize;
+
+    bool isFirstComponent = true;
+    for (uint8_t i = 0; i < _devicesTypesNb; i++) {
+        HABaseDeviceType* deviceType = _devicesTypes[i];
+        deviceType->buildSerializer();
+
+        if (deviceType->_serializer && deviceType->uniqueId()) {
+            if (!isFirstComponent) {
+                size += separatorSize;
+            }
+
+            size +=
+                propertySize + strlen(deviceType->uniqueId()) +
+                deviceType->_serializer->calculateSize(true);
+            isFirstComponent = false;
+        }
+
+        deviceType->destroySerializer();
+    }
+
+    return size;
+}
+
+bool HAMqtt::flushDeviceConfig()
+{
+    if (!_device.getSerializer()) {
+        return false;
+    }
+
+    writePayload(AHATOFSTR(HASerializerJsonDataPrefix));
+
+    // device
+    writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
+    writePayload(AHATOFSTR(HADeviceProperty));
+    writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
+
+    if (!_device.flushSerializedData()) {
+        return false;
+    }
+
+    // origin
+    writePayload(AHATOFSTR(HASerializerJsonPropertiesSeparator));
+    writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
+    writePayload(AHATOFSTR(HAOriginProperty));
+    writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
+    writePayload(AHATOFSTR(HASerializerJsonDataPrefix));
+    writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
+    writePayload(AHATOFSTR(HANameProperty));
+    writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
+    writePayload(AHATOFSTR(HASerializerJsonEscapeChar));
+    writePayload(AHATOFSTR(HAOriginName));
+    writePayload(AHATOFSTR(HASerializerJsonEscapeChar));
+    writePayload(AHATOFSTR(HASerializerJsonDataSuffix));
+
+    // components
+    writePayload(AHATOFSTR(HASerializerJsonPropertiesSeparator));
+    writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
+    writePayload(AHATOFSTR(HAComponentsProperty));
+    writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
+    writePayload(AHATOFSTR(HASerializerJsonDataPrefix));
+
+    bool result = true;
+    bool isFirstComponent = true;
+    for (uint8_t i = 0; i < _devicesTypesNb; i++) {
+        HABaseDeviceType* deviceType = _devicesTypes[i];
+        deviceType->buildSerializer();
+
+        if (result && deviceType->_serializer && deviceType->uniqueId()) {
+            if (!isFirstComponent) {
+                writePayload(AHATOFSTR(HASerializerJsonPropertiesSeparator));
+            }
+
+            const char* uniqueId = deviceType->uniqueId();
+            writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
+            writePayload(uniqueId, strlen(uniqueId));
+            writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
+
+            result = deviceType->_serializer->flush(true);
+            isFirstComponent = false;
+        }
+
+        deviceType->destroySerializer();
+    }
+
+    writePayload(AHATOFSTR(HASerializerJsonDataSuffix));
+    writePayload(AHATOFSTR(HASerializerJsonDataSuffix));
+    return result;
+}
+
+void HAMqtt::subscribeBirthTopic()
+{
+    if (!_discoveryPrefix) {
+        return;
+    }
+
+    char topic[
+        getDiscoveryPrefixLength() + 1 + // prefix with slash
+        strlen_P(HAStatusTopic) + 1 // including null terminator
+    ];
+    strcpy(topic, _discoveryPrefix);
+    strcat_P(topic, HASerializerSlash);
+    strcat_P(topic, HAStatusTopic);
+
+    subscribe(topic);
+}
+
+void HAMqtt::subscribeDeviceWildcard()
+{
+    if (!_dataPrefix || !_device.getUniqueId()) {
+        return;
+    }
+
+    char topic[
+        getDataPrefixLength() + 1 + // prefix with slash
+        strlen(_device.getUniqueId()) + 1 + // device ID with slash
+        4 // "+/+" and null terminator
+    ];
+    strcpy(topic, _dataPrefix);
+    strcat_P(topic, HASerializerSlash);
+    strcat(topic, _device.getUniqueId());
+    strcat_P(topic, HASerializerSlash);
+    strcat_P(topic, HASerializerWildcard);
+    strcat_P(topic, HASerializerSlash);
+    strcat_P(topic, HASerializerWildcard);
+
+    subscribe(topic);
+}
+
+bool HAMqtt::isBirthMessage(
+    const char* topic,
+    const uint8_t* payload,
+    const uint16_t length
+) const
+{
+    if (!topic || !payload || !_discoveryPrefix) {
+        return false;
+    }
+
+    const uint16_t prefixLength = getDiscoveryPrefixLength();
+    if (
+        strncmp(topic, _discoveryPrefix, prefixLength) != 0 ||
+        topic[prefixLength] != '/' ||
+        strcmp_P(&topic[prefixLength + 1], HAStatusTopic) != 0
+    ) {
+        return false;
+    }
+
+    return
+        length == strlen_P(HAOnline) &&
+        memcmp_P(payload, HAOnline, length) == 0;
+}
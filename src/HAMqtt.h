@@ -6,9 +6,16 @@
 #include <IPAddress.h>
 #include "ArduinoHADefines.h"
 
+#if defined(ARDUINOHA_ALLOCATION_STATS) && !defined(ARDUINOHA_TEST)
+#error "ARDUINOHA_ALLOCATION_STATS is available only in the host build (ARDUINOHA_TEST)"
+#endif
+
 #define HAMQTT_CALLBACK(name) void (*name)()
 #define HAMQTT_STATE_CALLBACK(name) void (*name)(ConnectionState state)
 #define HAMQTT_MESSAGE_CALLBACK(name) void (*name)(const char* topic, const uint8_t* payload, uint16_t length)
+#define HAMQTT_PROGRESS_CALLBACK(name) void (*name)(uint8_t processedNb, uint8_t totalNb)
+#define HAMQTT_CONFIG_HASH_LOAD_CALLBACK(name) uint32_t (*name)(const char* uniqueId)
+#define HAMQTT_CONFIG_HASH_SAVE_CALLBACK(name) void (*name)(const char* uniqueId, uint32_t hash)
 #define HAMQTT_DEFAULT_PORT 1883
 
 #ifdef ARDUINOHA_TEST
@@ -23,9 +30,39 @@ class PubSubClient;
 #define HAMQTT_DEFAULT_DEVICES_LIMIT 24
 #endif
 
+#if defined(__AVR__)
+#define HAMQTT_DEFAULT_WRITE_BUFFER_SIZE 64
+#else
+#define HAMQTT_DEFAULT_WRITE_BUFFER_SIZE 536
+#endif
+
+#if defined(__AVR__)
+#define HAMQTT_DEFAULT_SUBSCRIBE_BUFFER_SIZE 64
+#else
+#define HAMQTT_DEFAULT_SUBSCRIBE_BUFFER_SIZE 536
+#endif
+
 class HADevice;
 class HABaseDeviceType;
 
+#ifdef ARDUINOHA_ALLOCATION_STATS
+/**
+ * Heap usage statistics of a single library operation.
+ * See HAMqtt::getAllocationStats for details.
+ */
+struct HAAllocationStats
+{
+    /// The number of heap allocations made during the operation.
+    uint32_t allocationsNb;
+
+    /// The total number of bytes allocated during the operation.
+    uint32_t allocatedBytes;
+
+    /// The highest number of tracked bytes held on the heap while the operation was running.
+    uint32_t peakHeapBytes;
+};
+#endif
+
 #if defined(ARDUINO_API_VERSION)
 using namespace arduino;
 #endif
@@ -51,6 +88,47 @@ public:
         StateUnauthorized = 5
     };
 
+    /// Available modes of the topics' cache.
+    enum TopicsCacheMode {
+        /// Topics are generated from scratch each time they're needed. It's the default mode.
+        TopicsCacheDisabled = 0,
+
+        /// Only lengths of the topics' prefixes are cached. This mode saves RAM.
+        TopicsCacheLengths,
+
+        /// Full topics' prefixes are cached in RAM, so only the suffix needs to be appended.
+        TopicsCacheFull
+    };
+
+    /// Available modes of the commands' subscriptions.
+    enum SubscriptionMode {
+        /// Each command topic is subscribed separately. It's the default mode.
+        SubscriptionPerTopic = 0,
+
+        /// A single wildcard topic (`[data prefix]/[device ID]/[object ID]/+`) is subscribed per device type.
+        SubscriptionPerDeviceType,
+
+        /// A single wildcard topic (`[data prefix]/[device ID]/+/+`) is subscribed for the whole device.
+        SubscriptionPerDevice
+    };
+
+#ifdef ARDUINOHA_ALLOCATION_STATS
+    /// Library operations that have separate allocation statistics.
+    enum Operation {
+        /// Everything that happens outside of the operations listed below (constructors, setters, etc.).
+        OperationOther = 0,
+
+        /// Connection logic: publishing configurations, subscribing to topics, etc.
+        OperationConnect,
+
+        /// Processing of a message received from the broker, including the registered callbacks.
+        OperationMessage,
+
+        /// The number of operations (not an operation itself).
+        OperationsNb
+    };
+#endif
+
     /**
      * Returns existing instance (singleton) of the HAMqtt class.
      * It may be a null pointer if the HAMqtt object was never constructed or it was destroyed.
@@ -117,6 +195,56 @@ public:
     inline const char* getDataPrefix() const
         { return _dataPrefix; }
 
+    /**
+     * Enables caching of the topics' prefixes (`[data prefix]/[device ID]/[object ID]/`).
+     * The prefixes are calculated once in the HAMqtt::begin method, so prefixes and
+     * the device's unique ID must not be changed after calling the method.
+     * On AVR it's recommended to use HAMqtt::TopicsCacheLengths mode to save RAM.
+     *
+     * @param mode The mode of the cache.
+     */
+    inline void setTopicsCacheMode(const TopicsCacheMode mode)
+        { _topicsCacheMode = mode; }
+
+    /**
+     * Returns the mode of the topics' cache.
+     */
+    inline TopicsCacheMode getTopicsCacheMode() const
+        { return _topicsCacheMode; }
+
+    /**
+     * Sets the mode of the commands' subscriptions.
+     * In the wildcard modes the number of SUBSCRIBE packets sent after connecting to the broker
+     * doesn't depend on the number of command topics. Messages received on the wildcard topics
+     * are filtered locally by the device types, so the broker may also deliver messages that
+     * are published by the device itself (e.g. states).
+     * The mode is applied the next time the connection with the broker is acquired.
+     *
+     * @param mode The mode of the subscriptions.
+     */
+    inline void setSubscriptionMode(const SubscriptionMode mode)
+        { _subscriptionMode = mode; }
+
+    /**
+     * Returns the mode of the commands' subscriptions.
+     */
+    inline SubscriptionMode getSubscriptionMode() const
+        { return _subscriptionMode; }
+
+    /**
+     * Returns length of the discovery prefix.
+     * The cached value is used if the topics' cache is enabled.
+     */
+    inline uint16_t getDiscoveryPrefixLength() const
+        { return _discoveryPrefixLength > 0 ? _discoveryPrefixLength : strlen(_discoveryPrefix); }
+
+    /**
+     * Returns length of the data prefix.
+     * The cached value is used if the topics' cache is enabled.
+     */
+    inline uint16_t getDataPrefixLength() const
+        { return _dataPrefixLength > 0 ? _dataPrefixLength : strlen(_dataPrefix); }
+
     /**
      * Returns instance of the device assigned to the HAMqtt class.
      * It's the same object (pointer) that was passed to the HAMqtt constructor.
@@ -160,6 +288,165 @@ public:
     inline void onStateChanged(HAMQTT_STATE_CALLBACK(callback))
         { _stateChangedCallback = callback; }
 
+    /**
+     * Enables the device-level discovery.
+     * Configurations of all registered device types are published in a single message
+     * on the `[discovery prefix]/device/[device ID]/config` topic instead of a message per device type.
+     * The device's details are serialized only once in this mode.
+     * Please note that the device-level discovery requires Home Assistant 2024.11 or newer.
+     */
+    inline void enableDeviceDiscovery()
+        { _deviceDiscovery = true; }
+
+    /**
+     * Returns `true` if the device-level discovery is enabled.
+     */
+    inline bool isDeviceDiscoveryEnabled() const
+        { return _deviceDiscovery; }
+
+    /**
+     * Enables the cache of the published configurations (discovery messages).
+     * The hash of each device type's configuration is calculated before publishing.
+     * If the hash matches the previously published one, the configuration is not published again after reconnecting.
+     * All configurations are published again when Home Assistant sends its birth message
+     * (`[discovery prefix]/status` topic) or when HAMqtt::republishConfigs is called.
+     * The cache needs to be enabled before the HAMqtt::begin method is called.
+     */
+    void enableConfigCache();
+
+    /**
+     * Returns `true` if the cache of the published configurations is enabled.
+     */
+    inline bool isConfigCacheEnabled() const
+        { return _configHashes != nullptr; }
+
+    /**
+     * Registers a new callback method that will be called when the hash of the configuration
+     * is not known yet (e.g. after reboot). The callback should return the hash that was
+     * saved using the callback registered via HAMqtt::onConfigHashSave method or zero if there is no hash.
+     * Please note that the broker needs to persist retained messages if you want to use the storage.
+     *
+     * @param callback Callback method.
+     */
+    inline void onConfigHashLoad(HAMQTT_CONFIG_HASH_LOAD_CALLBACK(callback))
+        { _configHashLoadCallback = callback; }
+
+    /**
+     * Registers a new callback method that will be called each time the configuration
+     * with a new hash is published. It can be used to store hashes in EEPROM or in a file.
+     *
+     * @param callback Callback method.
+     */
+    inline void onConfigHashSave(HAMQTT_CONFIG_HASH_SAVE_CALLBACK(callback))
+        { _configHashSaveCallback = callback; }
+
+    /**
+     * Publishes configurations of all registered device types even if they didn't change.
+     * Nothing happens if the connection with the MQTT broker is not established.
+     */
+    void republishConfigs();
+
+    /**
+     * Registers a new callback method that will be called each time a device type finishes
+     * its connection phase (publishing configuration, availability, state and subscriptions).
+     * The phase of all device types is finished when `processedNb` equals `totalNb`.
+     *
+     * @param callback Callback method.
+     */
+    inline void onConnectProgress(HAMQTT_PROGRESS_CALLBACK(callback))
+        { _connectProgressCallback = callback; }
+
+    /**
+     * Spreads the connection phase of device types over successive HAMqtt::loop calls.
+     * Device types are processed one by one until one of the budgets is exceeded.
+     * The remaining device types are processed in the next loop call.
+     * At least one device type is processed in each call. Setting both budgets to zero disables the pacing.
+     * By default all device types are processed at once.
+     *
+     * @param bytesBudget The maximum number of bytes (topics and payloads) that can be sent in a single loop call.
+     * @param timeBudget The maximum time (milliseconds) that can be spent in a single loop call.
+     */
+    inline void setConnectPacing(const uint16_t bytesBudget, const uint16_t timeBudget = 0)
+        { _connectBytesBudget = bytesBudget; _connectTimeBudget = timeBudget; }
+
+    /**
+     * Returns `true` if the connection phase of all device types is finished.
+     */
+    inline bool isConnectPhaseFinished() const
+        { return _connectPhaseIndex >= _devicesTypesNb; }
+
+    /**
+     * Enables the write buffer that coalesces small writes of the payload.
+     * The payload is written to the network client in chunks of the given size instead of
+     * writing each JSON property (or even each byte) separately.
+     * The buffer is allocated once and it's kept until the HAMqtt is destroyed.
+     *
+     * @param size The size of the buffer. The default size matches the typical TCP segment size.
+     */
+    void enableWriteBuffer(const uint16_t size = HAMQTT_DEFAULT_WRITE_BUFFER_SIZE);
+
+    /**
+     * Enables batching of the subscriptions made in the connection phase.
+     * Topics subscribed by the HAMqtt::onConnected callback and by all device types are queued
+     * and sent in SUBSCRIBE packets carrying many topic filters instead of a packet per topic.
+     * The queue is flushed each time it gets full and at the end of each HAMqtt::loop call
+     * that processes the connection phase.
+     * The batched packets use identifiers from 32768 upwards, so they don't collide with PubSubClient's packets.
+     * The buffer is allocated once and it's kept until the HAMqtt is destroyed.
+     *
+     * @param size The size of the buffer (the maximum size of a single SUBSCRIBE packet).
+     */
+    void enableSubscriptionsBatching(const uint16_t size = HAMQTT_DEFAULT_SUBSCRIBE_BUFFER_SIZE);
+
+    /**
+     * Returns `true` if batching of the subscriptions is enabled.
+     */
+    inline bool isSubscriptionsBatchingEnabled() const
+        { return _subscribeBuffer != nullptr; }
+
+    /**
+     * Sets the staging buffer used for the single-pass serialization of the configurations.
+     * A configuration that fits the buffer is serialized once and published from the buffer.
+     * Larger configurations are serialized twice (size calculation and streaming to the MQTT).
+     * Use HAMqtt::getLargestStreamedPayloadSize method to find out how big the buffer should be.
+     *
+     * @note The HAMqtt class doesn't take ownership of the given buffer.
+     * @param buffer The buffer to use. Set it to nullptr to disable the single-pass serialization.
+     * @param size The size of the buffer.
+     */
+    inline void setStagingBuffer(char* buffer, const uint16_t size)
+        { _stagingBuffer = buffer; _stagingBufferSize = size; }
+
+    /**
+     * Returns the staging buffer set by HAMqtt::setStagingBuffer method. It can be nullptr.
+     */
+    inline char* getStagingBuffer() const
+        { return _stagingBuffer; }
+
+    /**
+     * Returns the size of the staging buffer.
+     */
+    inline uint16_t getStagingBufferSize() const
+        { return _stagingBufferSize; }
+
+    /**
+     * Returns the number of payloads that were serialized in a single pass using the staging buffer.
+     */
+    inline uint16_t getStagedPayloadsNb() const
+        { return _stagedPayloadsNb; }
+
+    /**
+     * Returns the number of payloads that didn't fit the staging buffer and were streamed.
+     */
+    inline uint16_t getStreamedPayloadsNb() const
+        { return _streamedPayloadsNb; }
+
+    /**
+     * Returns the size of the largest payload that didn't fit the staging buffer.
+     */
+    inline uint16_t getLargestStreamedPayloadSize() const
+        { return _largestStreamedPayloadSize; }
+
     /**
      * Returns the current state of the MQTT connection.
      */
@@ -322,6 +609,84 @@ public:
      */
     void writePayload(const __FlashStringHelper* data);
 
+    /**
+     * Starts calculating hash of the payload.
+     * Until HAMqtt::endPayloadHash is called, the data passed to the HAMqtt::writePayload methods
+     * is only used for calculating the hash and it's not written to the TCP stream.
+     *
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     * @param topic The topic of the message. It's included in the hash.
+     */
+    void beginPayloadHash(const char* topic);
+
+    /**
+     * Finishes calculating hash of the payload and returns the hash.
+     *
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     */
+    uint32_t endPayloadHash();
+
+    /**
+     * Starts capturing the payload to the given buffer.
+     * Until HAMqtt::endPayloadCapture is called, the data passed to the HAMqtt::writePayload methods
+     * is copied to the buffer and it's not written to the TCP stream.
+     *
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     * @param buffer The buffer where the payload will be copied.
+     * @param size The size of the buffer. Data that doesn't fit in the buffer is dropped.
+     */
+    void beginPayloadCapture(char* buffer, const uint16_t size);
+
+    /**
+     * Returns `true` if the payload is being captured to a buffer.
+     */
+    inline bool isCapturingPayload() const
+        { return _captureBuffer != nullptr; }
+
+    /**
+     * Finishes capturing the payload and returns the number of captured bytes.
+     * The returned number is larger than the size of the buffer if the payload didn't fit.
+     *
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     */
+    uint16_t endPayloadCapture();
+
+    /**
+     * Counts the payload serialized to the staging buffer.
+     * The payload is counted as streamed if it doesn't fit the buffer.
+     *
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     * @param length The length of the serialized payload.
+     */
+    void countStagedPayload(const uint16_t length);
+
+    /**
+     * Returns `true` if the configuration with the given hash was already published by the device type.
+     * The hash is loaded using the callback registered via HAMqtt::onConfigHashLoad if it's not known yet.
+     *
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     * @param deviceType The device type that owns the configuration or nullptr for the device-level configuration.
+     * @param hash The hash of the configuration.
+     */
+    bool isConfigPublished(const HABaseDeviceType* deviceType, const uint32_t hash);
+
+    /**
+     * Publishes configurations of all registered device types in a single message.
+     * It's used only if the device-level discovery is enabled.
+     *
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     */
+    void publishDeviceConfig();
+
+    /**
+     * Stores the hash of the configuration that was published by the device type.
+     *
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     * @param deviceType The device type that owns the configuration or nullptr for the device-level configuration.
+     * @param hash The hash of the configuration.
+     */
+    void setConfigPublished(const HABaseDeviceType* deviceType, const uint32_t hash);
+
     /**
      * Finishes publishing of a message.
      * After calling this method the message will be processed by the broker.
@@ -335,6 +700,8 @@ public:
      *
      * Please note that you need to subscribe topic each time the connection
      * with the broker is acquired.
+     * The topic is only queued if it's subscribed in the connection phase
+     * and batching of the subscriptions is enabled (see HAMqtt::enableSubscriptionsBatching).
      *
      * @param topic Topic to subscribe.
      */
@@ -361,6 +728,8 @@ public:
 
     /**
      * Processes MQTT message received from the broker (subscription).
+     * Messages received on data topics of the device are dispatched directly to the device type
+     * that owns the topic. All other messages are passed to all registered devices types.
      *
      * @note Do not use this method on your own. It's only for the internal purpose.
      * @param topic Topic of the message.
@@ -369,6 +738,47 @@ public:
      */
     void processMessage(const char* topic, const uint8_t* payload, uint16_t length);
 
+#ifdef ARDUINOHA_ALLOCATION_STATS
+    /**
+     * Returns heap usage statistics of the given operation.
+     * The statistics are available only in the host build (`ARDUINOHA_TEST`).
+     * Allocations are reported by the mocks that replace the global `new` and `delete` operators (see `mocks/HeapMock.h`).
+     *
+     * @param operation The operation.
+     */
+    inline const HAAllocationStats& getAllocationStats(const Operation operation) const
+        { return _allocationStats[operation]; }
+
+    /**
+     * Returns the number of tracked bytes that are currently held on the heap.
+     */
+    inline uint32_t getHeapBytes() const
+        { return _heapBytes; }
+
+    /**
+     * Resets statistics of all operations.
+     * The number of bytes currently held on the heap is kept.
+     */
+    void resetAllocationStats();
+
+    /**
+     * Reports the heap allocation of the given size.
+     * The allocation is assigned to the operation that is currently running.
+     *
+     * @param size The number of allocated bytes.
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     */
+    void trackAllocation(const size_t size);
+
+    /**
+     * Reports release of the heap block of the given size.
+     *
+     * @param size The number of released bytes.
+     * @note Do not use this method on your own. It's only for the internal purpose.
+     */
+    void trackDeallocation(const size_t size);
+#endif
+
 #ifdef ARDUINOHA_TEST
     inline uint8_t getDevicesTypesNb() const
         { return _devicesTypesNb; }
@@ -377,10 +787,57 @@ public:
         { return _devicesTypes; }
 #endif
 
+protected:
+#ifdef ARDUINOHA_TEST
+    /**
+     * Creates a new instance of the HAMqtt class that uses the given storage
+     * for the registered device types instead of allocating it on the heap.
+     * It's used by the HAMqttStatic class.
+     */
+    HAMqtt(
+        PubSubClientMock* pubSub,
+        HADevice& device,
+        HABaseDeviceType** devicesTypes,
+        uint8_t* devicesTypesIndex,
+        const uint8_t maxDevicesTypesNb
+    );
+#else
+    /**
+     * Creates a new instance of the HAMqtt class that uses the given storage
+     * for the registered device types instead of allocating it on the heap.
+     * It's used by the HAMqttStatic class.
+     *
+     * @param netClient The EthernetClient or WiFiClient that's going to be used for the network communication.
+     * @param device An instance of the HADevice class representing your device.
+     * @param devicesTypes The array for pointers of the registered device types.
+     * @param devicesTypesIndex The array for the index of device types. It needs to have the same size as `devicesTypes`.
+     * @param maxDevicesTypesNb The size of the given arrays.
+     */
+    HAMqtt(
+        Client& netClient,
+        HADevice& device,
+        HABaseDeviceType** devicesTypes,
+        uint8_t* devicesTypesIndex,
+        const uint8_t maxDevicesTypesNb
+    );
+#endif
+
 private:
     /// Interval between MQTT reconnects (milliseconds).
     static const uint16_t ReconnectInterval = 10000;
 
+    /// The first byte of the SUBSCRIBE packet (packet type with the flags required by MQTT 3.1.1).
+    static const uint8_t SubscribePacketType = 0x82;
+
+    /// Space reserved for the fixed header (up to 4 bytes of the remaining length) and the packet identifier.
+    static const uint8_t SubscribeHeaderSize = 7;
+
+    /**
+     * The first identifier of the SUBSCRIBE packets sent from the subscriptions' buffer.
+     * PubSubClient counts identifiers of its own packets from 1, so the batched packets use the upper half of the range.
+     */
+    static const uint16_t SubscribePacketIdBase = 0x8000;
+
     /// Living instance of the HAMqtt class. It can be nullptr.
     static HAMqtt* _instance;
 
@@ -395,11 +852,112 @@ private:
      */
     void onConnectedLogic();
 
+    /**
+     * Calls "onMqttConnected" method of the pending devices types until the budget
+     * set via HAMqtt::setConnectPacing is exceeded.
+     */
+    void processConnectPhase();
+
+    /**
+     * Sorts registered devices types by their unique IDs.
+     * The index is built lazily because some devices types (e.g. HADeviceTrigger)
+     * set their unique ID after being registered in the HAMqtt::addDeviceType method.
+     */
+    void buildDevicesTypesIndex();
+
+    /**
+     * Returns the registered device type with the given unique ID.
+     * The lookup uses binary search over the index built by the HAMqtt::buildDevicesTypesIndex method.
+     *
+     * @param uniqueId The unique ID to find (it doesn't need to be null terminated).
+     * @param length Length of the unique ID.
+     * @returns Pointer to the device type or nullptr if there is no device type with the given ID.
+     */
+    HABaseDeviceType* findDeviceType(const char* uniqueId, const uint16_t length);
+
     /**
      * Sets the state of the MQTT connection.
      */
     void setState(ConnectionState state);
 
+    /**
+     * Calculates prefixes of the topics if the cache is enabled.
+     * This method is called by the HAMqtt::begin method.
+     */
+    void cacheTopics();
+
+    /**
+     * Returns pointer to the hash of the configuration published by the given device type.
+     * The hash of the device-level configuration is returned if the device type is nullptr.
+     * It's nullptr if the cache is disabled or the device type is not registered.
+     */
+    uint32_t* getConfigHash(const HABaseDeviceType* deviceType) const;
+
+    /**
+     * Initializes the instance. It's called by all constructors.
+     */
+    void initialize();
+
+    /**
+     * Copies the given data to the write buffer.
+     * The buffer is flushed to the network client each time it gets full.
+     */
+    void bufferPayload(const uint8_t* data, uint16_t length, const bool isProgmemData);
+
+    /**
+     * Writes content of the write buffer to the network client.
+     */
+    void flushWriteBuffer();
+
+    /**
+     * Starts queueing the subscriptions if the batching is enabled.
+     */
+    void beginSubscriptionsBatch();
+
+    /**
+     * Sends the queued subscriptions and stops queueing.
+     */
+    void endSubscriptionsBatch();
+
+    /**
+     * Sends the queued subscriptions in a single SUBSCRIBE packet.
+     * Returns `false` if the packet couldn't be written to the network client.
+     */
+    bool flushSubscriptions();
+
+    /**
+     * Copies the given data to the capture buffer set by HAMqtt::beginPayloadCapture.
+     */
+    void capturePayload(const uint8_t* data, const uint16_t length, const bool isProgmemData);
+
+    /**
+     * Calculates the size of the device-level configuration.
+     * Serializers of all device types are built and destroyed by this method.
+     */
+    uint16_t calculateDeviceConfigSize();
+
+    /**
+     * Flushes the device-level configuration to the MQTT.
+     * Serializers of all device types are built and destroyed by this method.
+     */
+    bool flushDeviceConfig();
+
+    /**
+     * Subscribes to the topic of the Home Assistant's birth message.
+     */
+    void subscribeBirthTopic();
+
+    /**
+     * Subscribes to the wildcard topic of the device (`[data prefix]/[device ID]/+/+`).
+     * It's used only in the HAMqtt::SubscriptionPerDevice mode.
+     */
+    void subscribeDeviceWildcard();
+
+    /**
+     * Returns `true` if the given message is the birth message of the Home Assistant.
+     */
+    bool isBirthMessage(const char* topic, const uint8_t* payload, const uint16_t length) const;
+
 #ifdef ARDUINOHA_TEST
     PubSubClientMock* _mqtt;
 #else
@@ -422,6 +980,9 @@ private:
     /// The callback method that will be called when the MQTT connection state changes.
     HAMQTT_STATE_CALLBACK(_stateChangedCallback);
 
+    /// The callback method that will be called when a device type finishes its connection phase.
+    HAMQTT_PROGRESS_CALLBACK(_connectProgressCallback);
+
     /// Specifies whether the HAMqtt::begin method was ever called.
     bool _initialized;
 
@@ -449,6 +1010,15 @@ private:
     /// Pointers of all registered devices types (array of pointers).
     HABaseDeviceType** _devicesTypes;
 
+    /// Positions of the registered devices types in the `_devicesTypes` array sorted by their unique IDs.
+    uint8_t* _devicesTypesIndex;
+
+    /// The number of devices types in the index. The index is rebuilt if it doesn't match `_devicesTypesNb`.
+    uint8_t _devicesTypesIndexNb;
+
+    /// Specifies whether the arrays of devices types were allocated by the HAMqtt class.
+    bool _ownsDevicesTypes;
+
     /// The last will topic set by HAMqtt::setLastWill
     const char* _lastWillTopic;
 
@@ -460,6 +1030,146 @@ private:
 
     /// The last known state of the MQTT connection.
     ConnectionState _currentState;
+
+    /// The mode of the topics' cache.
+    TopicsCacheMode _topicsCacheMode;
+
+    /// The mode of the commands' subscriptions.
+    SubscriptionMode _subscriptionMode;
+
+    /// The cached length of the discovery prefix. It's zero if the cache is disabled.
+    uint16_t _discoveryPrefixLength;
+
+    /// The cached length of the data prefix. It's zero if the cache is disabled.
+    uint16_t _dataPrefixLength;
+
+    /// The maximum number of bytes sent in a single loop call during the connection phase. Zero means no limit.
+    uint16_t _connectBytesBudget;
+
+    /// The maximum time (milliseconds) spent in a single loop call during the connection phase. Zero means no limit.
+    uint16_t _connectTimeBudget;
+
+    /// Position of the next device type to process in the connection phase.
+    uint8_t _connectPhaseIndex;
+
+    /// The number of bytes (topics and payloads) sent since boot. It's used for the connection pacing.
+    uint32_t _sentBytesNb;
+
+    /// Hashes of the published configurations (one per device type). It's nullptr if the cache is disabled.
+    uint32_t* _configHashes;
+
+    /// The callback method that will be called when the hash of the configuration is not known.
+    HAMQTT_CONFIG_HASH_LOAD_CALLBACK(_configHashLoadCallback);
+
+    /// The callback method that will be called when the configuration with a new hash is published.
+    HAMQTT_CONFIG_HASH_SAVE_CALLBACK(_configHashSaveCallback);
+
+    /// Specifies whether the device-level discovery is enabled.
+    bool _deviceDiscovery;
+
+    /// Specifies whether configurations should be published even if they didn't change.
+    bool _forceConfigPublish;
+
+    /// Specifies whether the payload is being hashed instead of being written to the TCP stream.
+    bool _hashingPayload;
+
+    /// The hash of the payload calculated between HAMqtt::beginPayloadHash and HAMqtt::endPayloadHash calls.
+    uint32_t _payloadHash;
+
+    /// The buffer set by HAMqtt::beginPayloadCapture. It's nullptr if the payload is not being captured.
+    char* _captureBuffer;
+
+    /// The size of the capture buffer.
+    uint16_t _captureBufferSize;
+
+    /// The number of bytes written to the capture buffer (including bytes that didn't fit).
+    uint16_t _captureLength;
+
+    /// The buffer set by HAMqtt::setStagingBuffer. It can be nullptr.
+    char* _stagingBuffer;
+
+    /// The size of the staging buffer.
+    uint16_t _stagingBufferSize;
+
+    /// The number of payloads serialized in a single pass.
+    uint16_t _stagedPayloadsNb;
+
+    /// The number of payloads that didn't fit the staging buffer.
+    uint16_t _streamedPayloadsNb;
+
+    /// The size of the largest payload that didn't fit the staging buffer.
+    uint16_t _largestStreamedPayloadSize;
+
+#ifdef ARDUINOHA_ALLOCATION_STATS
+    /// The operation that is currently running.
+    Operation _operation;
+
+    /// Allocation statistics of each operation.
+    HAAllocationStats _allocationStats[OperationsNb];
+
+    /// The number of tracked bytes that are currently held on the heap.
+    uint32_t _heapBytes;
+
+#endif
+    /// The buffer allocated by HAMqtt::enableWriteBuffer. It's nullptr if the buffer is disabled.
+    uint8_t* _writeBuffer;
+
+    /// The size of the write buffer.
+    uint16_t _writeBufferSize;
+
+    /// The number of bytes waiting in the write buffer.
+    uint16_t _writeBufferLength;
+
+    /// The buffer allocated by HAMqtt::enableSubscriptionsBatching. It's nullptr if the batching is disabled.
+    uint8_t* _subscribeBuffer;
+
+    /// The size of the subscriptions' buffer.
+    uint16_t _subscribeBufferSize;
+
+    /// The number of bytes used in the subscriptions' buffer (including the reserved header). It's zero if the queue is empty.
+    uint16_t _subscribeBufferLength;
+
+    /// Specifies whether the subscriptions are being queued.
+    bool _batchingSubscriptions;
+
+    /// The identifier of the last SUBSCRIBE packet sent from the subscriptions' buffer (see HAMqtt::SubscribePacketIdBase).
+    uint16_t _subscribePacketId;
+};
+
+/**
+ * The HAMqtt class that keeps the registered device types in a fixed-size array
+ * instead of allocating it on the heap. The capacity is set at compile time.
+ * Combined with the `ARDUINOHA_STATIC_MEMORY` macro, the library doesn't use the heap after construction.
+ *
+ * @tparam MaxDevicesTypesNb The maximum number of device types (sensors, switches, etc.) that you're going to implement.
+ */
+template <uint8_t MaxDevicesTypesNb>
+class HAMqttStatic : public HAMqtt
+{
+public:
+#ifdef ARDUINOHA_TEST
+    explicit HAMqttStatic(PubSubClientMock* pubSub, HADevice& device) :
+        HAMqtt(pubSub, device, _devicesTypesStorage, _devicesTypesIndexStorage, MaxDevicesTypesNb)
+    { }
+#else
+    /**
+     * Creates a new instance of the HAMqttStatic class.
+     * Please note that only one instance of the HAMqtt class can be initialized at the same time.
+     *
+     * @param netClient The EthernetClient or WiFiClient that's going to be used for the network communication.
+     * @param device An instance of the HADevice class representing your device.
+     */
+    explicit HAMqttStatic(Client& netClient, HADevice& device) :
+        HAMqtt(netClient, device, _devicesTypesStorage, _devicesTypesIndexStorage, MaxDevicesTypesNb)
+    { }
+#endif
+
+private:
+    /// Storage for pointers of the registered device types.
+    HABaseDeviceType* _devicesTypesStorage[MaxDevicesTypesNb];
+
+    /// Storage for the index of the registered device types.
+    uint8_t _devicesTypesIndexStorage[MaxDevicesTypesNb];
 };
 
 #endif
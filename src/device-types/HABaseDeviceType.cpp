@@ -13,13 +13,25 @@ HABaseDeviceType::HABaseDeviceType(
     _name(nullptr),
     _objectId(nullptr),
     _serializer(nullptr),
-    _availability(AvailabilityDefault)
+    _availability(AvailabilityDefault),
+    _subscribedCommands(0),
+    _dataTopicPrefixLength(0),
+    _dataTopicPrefix(nullptr)
 {
     if (mqtt()) {
         mqtt()->addDeviceType(this);
     }
 }
 
+HABaseDeviceType::~HABaseDeviceType()
+{
+    if (_dataTopicPrefix) {
+        delete[] _dataTopicPrefix;
+    }
+
+    destroySerializer();
+}
+
 void HABaseDeviceType::setAvailability(bool online)
 {
     _availability = (online ? AvailabilityOnline : AvailabilityOffline);
@@ -31,29 +43,141 @@ HAMqtt* HABaseDeviceType::mqtt()
     return HAMqtt::instance();
 }
 
+uint16_t HABaseDeviceType::calculateDataTopicLength(
+    const __FlashStringHelper* topic
+) const
+{
+    if (_dataTopicPrefixLength == 0 || !topic) {
+        return HASerializer::calculateDataTopicLength(uniqueId(), topic);
+    }
+
+    return _dataTopicPrefixLength + strlen_P(AHAFROMFSTR(topic)) + 1; // including null terminator
+}
+
+bool HABaseDeviceType::generateDataTopic(
+    char* output,
+    const __FlashStringHelper* topic
+) const
+{
+    if (!_dataTopicPrefix || !output || !topic) {
+        return HASerializer::generateDataTopic(output, uniqueId(), topic);
+    }
+
+    memcpy(output, _dataTopicPrefix, _dataTopicPrefixLength);
+    strcpy_P(&output[_dataTopicPrefixLength], AHAFROMFSTR(topic));
+    return true;
+}
+
 void HABaseDeviceType::subscribeTopic(
     const char* uniqueId,
     const __FlashStringHelper* topic
 )
 {
-    const uint16_t topicLength = HASerializer::calculateDataTopicLength(
-        uniqueId,
-        topic
-    );
+    const bool isOwnTopic = uniqueId == this->uniqueId();
+    HAMqtt* mqtt = HAMqtt::instance();
+    if (isOwnTopic && mqtt) {
+        const HAMqtt::SubscriptionMode mode = mqtt->getSubscriptionMode();
+        if (mode == HAMqtt::SubscriptionPerDevice) {
+            return; // the topic is covered by the device's wildcard subscription
+        }
+
+        if (mode == HAMqtt::SubscriptionPerDeviceType) {
+            if (_subscribedCommands & WildcardSubscribed) {
+                return; // the topic is covered by the device type's wildcard subscription
+            }
+
+            _subscribedCommands |= WildcardSubscribed;
+            topic = AHATOFSTR(HASerializerWildcard);
+        }
+    }
+
+    const uint16_t topicLength = isOwnTopic
+        ? calculateDataTopicLength(topic)
+        : HASerializer::calculateDataTopicLength(uniqueId, topic);
     if (topicLength == 0) {
         return;
     }
 
     char fullTopic[topicLength];
-    if (!HASerializer::generateDataTopic(
-        fullTopic,
-        uniqueId,
-        topic
-    )) {
+    if (
+        isOwnTopic
+            ? !generateDataTopic(fullTopic, topic)
+            : !HASerializer::generateDataTopic(fullTopic, uniqueId, topic)
+    ) {
         return;
     }
 
-    HAMqtt::instance()->subscribe(fullTopic);
+    mqtt->subscribe(fullTopic);
+}
+
+void HABaseDeviceType::subscribeCommands(
+    const CommandEntry* commands,
+    const uint8_t commandsNb,
+    const uint16_t features,
+    const uint8_t callbacks
+)
+{
+    for (uint8_t i = 0; i < commandsNb && i < MaxCommandsNb; i++) {
+        const uint8_t bit = 1 << i;
+        if (!(callbacks & bit) || (_subscribedCommands & bit)) {
+            continue;
+        }
+
+        CommandEntry command;
+        memcpy_P(&command, &commands[i], sizeof(CommandEntry));
+
+        if (command.features == 0 || (command.features & features)) {
+            subscribeTopic(uniqueId(), AHATOFSTR(command.topic));
+            _subscribedCommands |= bit;
+        }
+    }
+}
+
+void HABaseDeviceType::subscribeCommand(const __FlashStringHelper* topic)
+{
+    if (_subscribedCommands & 1) {
+        return;
+    }
+
+    subscribeTopic(uniqueId(), topic);
+    _subscribedCommands |= 1;
+}
+
+void HABaseDeviceType::refreshCommandSubscriptions()
+{
+    if (uniqueId() && mqtt() && mqtt()->isConnected()) {
+        subscribeCommandTopics();
+    }
+}
+
+bool HABaseDeviceType::dispatchCommand(
+    const CommandEntry* commands,
+    const uint8_t commandsNb,
+    const uint16_t features,
+    const char* topic,
+    const uint8_t* payload,
+    const uint16_t length
+)
+{
+    const char* topicName = HASerializer::matchDataTopicPrefix(topic, uniqueId());
+    if (!topicName) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < commandsNb; i++) {
+        CommandEntry command;
+        memcpy_P(&command, &commands[i], sizeof(CommandEntry));
+
+        if (
+            (command.features == 0 || (command.features & features)) &&
+            strcmp_P(topicName, command.topic) == 0
+        ) {
+            (this->*command.handler)(payload, length);
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void HABaseDeviceType::onMqttMessage(
@@ -67,6 +191,12 @@ void HABaseDeviceType::onMqttMessage(
     (void)length;
 }
 
+const void* HABaseDeviceType::getSerializerValue(const uint8_t field) const
+{
+    (void)field;
+    return nullptr;
+}
+
 void HABaseDeviceType::destroySerializer()
 {
     if (_serializer) {
@@ -77,29 +207,58 @@ void HABaseDeviceType::destroySerializer()
 
 void HABaseDeviceType::publishConfig()
 {
+    if (mqtt()->isDeviceDiscoveryEnabled()) {
+        return; // the config is published by the HAMqtt in the device-level message
+    }
+
     buildSerializer();
 
     if (_serializer == nullptr) {
         return;
     }
 
-    const uint16_t topicLength = HASerializer::calculateConfigTopicLength(
-        componentName(),
-        uniqueId()
-    );
-    const uint16_t dataLength = _serializer->calculateSize();
-
-    if (topicLength > 0 && dataLength > 0) {
+    const uint16_t topicLength = calculateConfigTopicLength();
+    if (topicLength > 0) {
         char topic[topicLength];
-        HASerializer::generateConfigTopic(
-            topic,
-            componentName(),
-            uniqueId()
-        );
+        generateConfigTopic(topic);
+
+        // the config is serialized only once if it fits the staging buffer
+        const uint16_t stagedLength = _serializer->stage();
+        const bool isStaged =
+            stagedLength > 0 &&
+            stagedLength <= mqtt()->getStagingBufferSize();
+        uint32_t hash = 0;
+
+        if (mqtt()->isConfigCacheEnabled()) {
+            if (isStaged) {
+                mqtt()->beginPayloadHash(topic);
+                mqtt()->writePayload(mqtt()->getStagingBuffer(), stagedLength);
+                hash = mqtt()->endPayloadHash();
+            } else {
+                hash = _serializer->calculateHash(topic);
+            }
+        }
+
+        if (hash != 0 && mqtt()->isConfigPublished(this, hash)) {
+            ARDUINOHA_DEBUG_PRINT(F("AHA: config didn't change "))
+            ARDUINOHA_DEBUG_PRINTLN(topic)
+        } else {
+            // the length of the streamed config is already known if the staging was attempted
+            const uint16_t dataLength = stagedLength > 0
+                ? stagedLength
+                : _serializer->calculateSize();
 
-        if (mqtt()->beginPublish(topic, dataLength, true)) {
-            _serializer->flush();
-            mqtt()->endPublish();
+            if (dataLength > 0 && mqtt()->beginPublish(topic, dataLength, true)) {
+                if (isStaged) {
+                    mqtt()->writePayload(mqtt()->getStagingBuffer(), stagedLength);
+                } else {
+                    _serializer->flush();
+                }
+
+                if (mqtt()->endPublish() && hash != 0) {
+                    mqtt()->setConfigPublished(this, hash);
+                }
+            }
         }
     }
 
@@ -175,20 +334,13 @@ bool HABaseDeviceType::publishOnDataTopic(
         return false;
     }
 
-    const uint16_t topicLength = HASerializer::calculateDataTopicLength(
-        uniqueId(),
-        topic
-    );
+    const uint16_t topicLength = calculateDataTopicLength(topic);
     if (topicLength == 0) {
         return false;
     }
 
     char fullTopic[topicLength];
-    if (!HASerializer::generateDataTopic(
-        fullTopic,
-        uniqueId(),
-        topic
-    )) {
+    if (!generateDataTopic(fullTopic, topic)) {
         return false;
     }
 
@@ -203,4 +355,84 @@ bool HABaseDeviceType::publishOnDataTopic(
     }
 
     return false;
+}
+
+void HABaseDeviceType::cacheTopics(const bool lengthOnly)
+{
+    if (_dataTopicPrefix) {
+        delete[] _dataTopicPrefix;
+        _dataTopicPrefix = nullptr;
+    }
+
+    _dataTopicPrefixLength = 0;
+
+    const HAMqtt* mqtt = HAMqtt::instance();
+    if (
+        !uniqueId() ||
+        !mqtt ||
+        !mqtt->getDataPrefix() ||
+        !mqtt->getDevice() ||
+        !mqtt->getDevice()->getUniqueId()
+    ) {
+        return;
+    }
+
+    const char* deviceUniqueId = mqtt->getDevice()->getUniqueId();
+    const uint16_t prefixLength =
+        mqtt->getDataPrefixLength() + 1 + // prefix with slash
+        strlen(deviceUniqueId) + 1 + // device ID with slash
+        strlen(uniqueId()) + 1; // object ID with slash
+
+    if (!lengthOnly) {
+        _dataTopicPrefix = new char[prefixLength + 1]; // including null terminator
+        strcpy(_dataTopicPrefix, mqtt->getDataPrefix());
+        strcat_P(_dataTopicPrefix, HASerializerSlash);
+        strcat(_dataTopicPrefix, deviceUniqueId);
+        strcat_P(_dataTopicPrefix, HASerializerSlash);
+        strcat(_dataTopicPrefix, uniqueId());
+        strcat_P(_dataTopicPrefix, HASerializerSlash);
+    }
+
+    _dataTopicPrefixLength = prefixLength;
+}
+
+uint16_t HABaseDeviceType::calculateConfigTopicLength() const
+{
+    const HAMqtt* mqtt = HAMqtt::instance();
+    if (_dataTopicPrefixLength == 0 || !mqtt || !mqtt->getDiscoveryPrefix()) {
+        return HASerializer::calculateConfigTopicLength(
+            componentName(),
+            uniqueId()
+        );
+    }
+
+    // the data prefix is replaced with the discovery prefix and the component name
+    return
+        _dataTopicPrefixLength - mqtt->getDataPrefixLength() +
+        mqtt->getDiscoveryPrefixLength() +
+        strlen_P(AHAFROMFSTR(componentName())) + 1 + // component name with slash
+        strlen_P(HAConfigTopic) + 1; // including null terminator
+}
+
+bool HABaseDeviceType::generateConfigTopic(char* output) const
+{
+    const HAMqtt* mqtt = HAMqtt::instance();
+    if (!_dataTopicPrefix || !mqtt || !mqtt->getDiscoveryPrefix()) {
+        return HASerializer::generateConfigTopic(
+            output,
+            componentName(),
+            uniqueId()
+        );
+    }
+
+    strcpy(output, mqtt->getDiscoveryPrefix());
+    strcat_P(output, HASerializerSlash);
+
+    strcat_P(output, AHAFROMFSTR(componentName()));
+    strcat_P(output, HASerializerSlash);
+
+    // "[device ID]/[object ID]/" part of the data topics' prefix
+    strcat(output, &_dataTopicPrefix[mqtt->getDataPrefixLength() + 1]);
+    strcat_P(output, HAConfigTopic);
+    return true;
 }
\ No newline at end of file
@@ -7,6 +7,21 @@
 class HAMqtt;
 class HASerializer;
 
+/**
+ * Creates a row of the device type's command table (see HABaseDeviceType::CommandEntry).
+ *
+ * @param topic The command topic's name (progmem string), e.g. `HACommandTopic`.
+ * @param features Features that enable the command. Use `0` if the command is always available.
+ * @param type The class of the device type.
+ * @param handler The name of the method that handles the command.
+ */
+#define HACOMMAND(topic, features, type, handler) \
+    {topic, features, static_cast<HABaseDeviceType::CommandHandler>(&type::handler)}
+
+/// Returns the number of commands in the given table.
+#define HACOMMANDS_NB(commands) \
+    static_cast<uint8_t>(sizeof(commands) / sizeof(HABaseDeviceType::CommandEntry))
+
 class HABaseDeviceType
 {
 public:
@@ -24,6 +39,28 @@ public:
         PrecisionP3
     };
 
+    /// The method that handles the command's payload.
+    typedef void (HABaseDeviceType::*CommandHandler)(const uint8_t* cmd, const uint16_t length);
+
+    /// The maximum number of commands in the table passed to HABaseDeviceType::subscribeCommands.
+    static const uint8_t MaxCommandsNb = 7;
+
+    /**
+     * Describes a single command topic of the device type.
+     * Device types keep these entries in tables stored in the flash memory (use the HACOMMAND macro).
+     */
+    struct CommandEntry
+    {
+        /// The topic's name (progmem string).
+        const char* topic;
+
+        /// Features that enable the command (any of them). `0` means that the command is always available.
+        uint16_t features;
+
+        /// The method that handles the command's payload.
+        CommandHandler handler;
+    };
+
     /**
      * Creates a new device type instance and registers it in the HAMqtt class.
      *
@@ -37,6 +74,15 @@ public:
         const char* uniqueId
     );
 
+    /**
+     * Frees the memory allocated by the topics' cache.
+     */
+    virtual ~HABaseDeviceType();
+
+    /// Device types own the cached topics' prefix and they are registered in the HAMqtt by their address.
+    HABaseDeviceType(const HABaseDeviceType&) = delete;
+    HABaseDeviceType& operator=(const HABaseDeviceType&) = delete;
+
     /**
      * Returns unique ID of the device type.
      */
@@ -104,6 +150,24 @@ public:
      */
     virtual void setAvailability(bool online);
 
+    /**
+     * Calculates the size of the given data topic of this device type (including null terminator).
+     * The cached prefix length is used if the topics' cache is enabled in the HAMqtt.
+     *
+     * @param topic The topic name (progmem string).
+     */
+    uint16_t calculateDataTopicLength(const __FlashStringHelper* topic) const;
+
+    /**
+     * Generates the given data topic of this device type.
+     * The cached prefix is used if the topics' cache is enabled in the HAMqtt.
+     *
+     * @param output Buffer where the topic will be written.
+     *               The size of the buffer should be calculated using HABaseDeviceType::calculateDataTopicLength method.
+     * @param topic The topic name (progmem string).
+     */
+    bool generateDataTopic(char* output, const __FlashStringHelper* topic) const;
+
 #ifdef ARDUINOHA_TEST
     inline HASerializer* getSerializer() const
         { return _serializer; }
@@ -120,15 +184,72 @@ protected:
 
     /**
      * Subscribes to the given data topic.
+     * Own topics are replaced with the wildcard subscription if it's enabled via HAMqtt::setSubscriptionMode.
      *
      * @param uniqueId THe unique ID of the device type assigned via the constructor.
      * @param topic Topic to subscribe (progmem string).
      */
-    static void subscribeTopic(
+    void subscribeTopic(
         const char* uniqueId,
         const __FlashStringHelper* topic
     );
 
+    /**
+     * Subscribes to the command topics of the given table.
+     * Commands of the features that are disabled and commands without a registered callback are skipped.
+     *
+     * @param commands The table of commands (stored in the flash memory).
+     * @param commandsNb The number of commands in the table.
+     * @param features The features that are enabled in the device type.
+     * @param callbacks The N-th bit is set if the N-th command of the table has a registered callback.
+     * @note Commands that are already subscribed in the current connection are skipped.
+     *       The table can have up to 7 commands (see HABaseDeviceType::MaxCommandsNb).
+     */
+    void subscribeCommands(
+        const CommandEntry* commands,
+        const uint8_t commandsNb,
+        const uint16_t features,
+        const uint8_t callbacks
+    );
+
+    /**
+     * Subscribes to the command topic of the device type that has a single command.
+     * The topic is subscribed once per connection.
+     *
+     * @param topic The command topic to subscribe (progmem string).
+     */
+    void subscribeCommand(const __FlashStringHelper* topic);
+
+    /**
+     * Subscribes to the command topics whose callbacks were registered after connecting to the broker.
+     * Topics that are already subscribed in the current connection are not subscribed again.
+     * Setters of the command callbacks call this method, so callbacks can be also registered at runtime.
+     * Please note that clearing the callback doesn't unsubscribe the topic until reconnecting.
+     */
+    void refreshCommandSubscriptions();
+
+    /**
+     * Calls the handler of the command that owns the given topic.
+     * The prefix of the topic is matched once and then only the topic's name is compared with the table.
+     * Commands of the features that are disabled are never considered.
+     *
+     * @param commands The table of commands (stored in the flash memory).
+     * @param commandsNb The number of commands in the table.
+     * @param features The features that are enabled in the device type.
+     * @param topic The topic on which the message was produced.
+     * @param payload The payload of the message.
+     * @param length The length of the payload.
+     * @returns Returns `true` if the message has been handled by one of the commands.
+     */
+    bool dispatchCommand(
+        const CommandEntry* commands,
+        const uint8_t commandsNb,
+        const uint16_t features,
+        const char* topic,
+        const uint8_t* payload,
+        const uint16_t length
+    );
+
     /**
      * This method should build serializer that will be used for publishing the configuration.
      * The serializer is built each time the MQTT connection is acquired.
@@ -136,6 +257,15 @@ protected:
      */
     virtual void buildSerializer() { };
 
+    /**
+     * Returns pointer to the value of the given field for the serializer that walks a schema.
+     * The field is a number defined by the schema of the device type (see HASerializer::SchemaEntry).
+     * The property is skipped in the output if the nullptr is returned.
+     *
+     * @param field The field of the device type.
+     */
+    virtual const void* getSerializerValue(const uint8_t field) const;
+
     /**
      * This method is called each time the MQTT connection is acquired.
      * Each device type should publish its configuration and availability.
@@ -143,9 +273,17 @@ protected:
      */
     virtual void onMqttConnected() = 0;
 
+    /**
+     * This method should subscribe to the command topics that have a registered callback.
+     * It's called by the onMqttConnected method of the device type and
+     * each time a command callback is registered while the connection is acquired.
+     */
+    virtual void subscribeCommandTopics() { };
+
     /**
      * This method is called each time the device receives a MQTT message.
-     * It can be any MQTT message so the method should always verify the topic.
+     * Messages produced on data topics of the device are only passed to the device type that owns the topic.
+     * Other messages are passed to all device types, so the method should always verify the topic.
      *
      * @param topic The topic on which the message was produced.
      * @param payload The payload of the message. It can be nullptr.
@@ -164,6 +302,8 @@ protected:
 
     /**
      * Publishes configuration of this device type on the HA discovery topic.
+     * If the config cache is enabled in the HAMqtt, the configuration is skipped when it didn't change.
+     * Nothing happens if the device-level discovery is enabled in the HAMqtt.
      */
     void publishConfig();
 
@@ -232,15 +372,52 @@ protected:
     HASerializer* _serializer;
 
 private:
+    /// The bit of `_subscribedCommands` that's set if the wildcard topic is subscribed (HAMqtt::SubscriptionPerDeviceType mode).
+    static const uint8_t WildcardSubscribed = 1 << MaxCommandsNb;
+
     enum Availability {
         AvailabilityDefault = 0,
         AvailabilityOnline,
         AvailabilityOffline
     };
 
+    /**
+     * Calculates the prefix of the data topics (`[data prefix]/[device ID]/[object ID]/`)
+     * and stores it in the cache. This method is called by the HAMqtt class.
+     *
+     * @param lengthOnly Specifies whether only the length of the prefix should be cached.
+     */
+    void cacheTopics(const bool lengthOnly);
+
+    /**
+     * Calculates the size of the configuration topic (including null terminator).
+     */
+    uint16_t calculateConfigTopicLength() const;
+
+    /**
+     * Generates the configuration topic of this device type.
+     *
+     * @param output Buffer where the topic will be written.
+     */
+    bool generateConfigTopic(char* output) const;
+
     /// The current availability of this device type. AvailabilityDefault means that the initial availability was never set.
     Availability _availability;
+
+    /**
+     * The N-th bit is set if the N-th command topic is subscribed in the current connection.
+     * The highest bit (HABaseDeviceType::WildcardSubscribed) is set if the device type's wildcard topic is subscribed.
+     * It's reset by the HAMqtt on connect.
+     */
+    uint8_t _subscribedCommands;
+
+    /// The cached length of the data topics' prefix (without null terminator). It's zero if the cache is disabled.
+    uint16_t _dataTopicPrefixLength;
+
+    /// The cached prefix of the data topics (with null terminator). It's nullptr unless the full cache is enabled.
+    char* _dataTopicPrefix;
     friend class HAMqtt;
+    friend class HASerializer;
 };
 
 #endif
@@ -43,6 +43,10 @@ void HABinarySensor::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 9); // 9 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
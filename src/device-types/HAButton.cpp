@@ -21,6 +21,10 @@ void HAButton::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 9); // 9 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -49,7 +53,14 @@ void HAButton::onMqttConnected()
 
     publishConfig();
     publishAvailability();
-    subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    subscribeCommandTopics();
+}
+
+void HAButton::subscribeCommandTopics()
+{
+    if (_commandCallback) {
+        subscribeCommand(AHATOFSTR(HACommandTopic));
+    }
 }
 
 void HAButton::onMqttMessage(
@@ -28,6 +28,10 @@ void HACamera::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 8); // 8 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -4,8 +4,15 @@
 #include "../HAMqtt.h"
 #include "../utils/HAUtils.h"
 #include "../utils/HANumeric.h"
+#include "../utils/HAKeywords.h"
 #include "../utils/HASerializer.h"
 
+static const HAKeyword CommandKeywords[] PROGMEM = {
+    {HAOpenCommand, HACover::CommandOpen},
+    {HACloseCommand, HACover::CommandClose},
+    {HAStopCommand, HACover::CommandStop}
+};
+
 HACover::HACover(const char* uniqueId, const Features features) :
     HABaseDeviceType(AHATOFSTR(HAComponentCover), uniqueId),
     _features(features),
@@ -55,6 +62,10 @@ void HACover::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 12); // 12 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -101,7 +112,14 @@ void HACover::onMqttConnected()
         publishPosition(_currentPosition);
     }
 
-    subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    subscribeCommandTopics();
+}
+
+void HACover::subscribeCommandTopics()
+{
+    if (_commandCallback) {
+        subscribeCommand(AHATOFSTR(HACommandTopic));
+    }
 }
 
 void HACover::onMqttMessage(
@@ -172,12 +190,15 @@ void HACover::handleCommand(const uint8_t* cmd, const uint16_t length)
         return;
     }
 
-    if (memcmp_P(cmd, HACloseCommand, length) == 0) {
-        _commandCallback(CommandClose, this);
-    } else if (memcmp_P(cmd, HAOpenCommand, length) == 0) {
-        _commandCallback(CommandOpen, this);
-    } else if (memcmp_P(cmd, HAStopCommand, length) == 0) {
-        _commandCallback(CommandStop, this);
+    uint8_t command;
+    if (HAKeywords::decode(
+        CommandKeywords,
+        HAKEYWORDS_NB(CommandKeywords),
+        cmd,
+        length,
+        command
+    )) {
+        _commandCallback(static_cast<CoverCommand>(command), this);
     }
 }
 
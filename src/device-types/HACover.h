@@ -145,11 +145,12 @@ public:
      * @param callback
      */
     inline void onCommand(HACOVER_CALLBACK(callback))
-        { _commandCallback = callback; }
+        { _commandCallback = callback; refreshCommandSubscriptions(); }
 
 protected:
     virtual void buildSerializer() override;
     virtual void onMqttConnected() override;
+    virtual void subscribeCommandTopics() override;
     virtual void onMqttMessage(
         const char* topic,
         const uint8_t* payload,
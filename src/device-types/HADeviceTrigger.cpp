@@ -67,6 +67,10 @@ void HADeviceTrigger::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 5); // 5 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(
         AHATOFSTR(HAAutomationTypeProperty),
         AHATOFSTR(HATrigger),
@@ -5,6 +5,11 @@
 #include "../utils/HAUtils.h"
 #include "../utils/HASerializer.h"
 
+const HABaseDeviceType::CommandEntry HAFan::Commands[] PROGMEM = {
+    HACOMMAND(HACommandTopic, 0, HAFan, handleStateCommand),
+    HACOMMAND(HAPercentageCommandTopic, SpeedsFeature, HAFan, handleSpeedCommand)
+};
+
 HAFan::HAFan(const char* uniqueId, const uint8_t features) :
     HABaseDeviceType(AHATOFSTR(HAComponentFan), uniqueId),
     _features(features),
@@ -56,6 +61,10 @@ void HAFan::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 14); // 14 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -118,11 +127,19 @@ void HAFan::onMqttConnected()
         publishSpeed(_currentSpeed);
     }
 
-    subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    subscribeCommandTopics();
+}
 
-    if (_features & SpeedsFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HAPercentageCommandTopic));
-    }
+void HAFan::subscribeCommandTopics()
+{
+    static_assert(HACOMMANDS_NB(Commands) <= MaxCommandsNb, "Commands don't fit the callbacks' mask");
+
+    // bits follow the order of the commands table
+    const uint8_t callbacks =
+        (_stateCallback ? 1 : 0) |
+        (_speedCallback ? 2 : 0);
+
+    subscribeCommands(Commands, HACOMMANDS_NB(Commands), _features, callbacks);
 }
 
 void HAFan::onMqttMessage(
@@ -131,19 +148,14 @@ void HAFan::onMqttMessage(
     const uint16_t length
 )
 {
-    if (HASerializer::compareDataTopics(
+    dispatchCommand(
+        Commands,
+        HACOMMANDS_NB(Commands),
+        _features,
         topic,
-        uniqueId(),
-        AHATOFSTR(HACommandTopic)
-    )) {
-        handleStateCommand(payload, length);
-    } else if (HASerializer::compareDataTopics(
-        topic,
-        uniqueId(),
-        AHATOFSTR(HAPercentageCommandTopic)
-    )) {
-        handleSpeedCommand(payload, length);
-    }
+        payload,
+        length
+    );
 }
 
 bool HAFan::publishState(const bool state)
@@ -156,7 +156,7 @@ public:
      * @note In non-optimistic mode, the state must be reported back to HA using the HAFan::setState method.
      */
     inline void onStateCommand(HAFAN_STATE_CALLBACK(callback))
-        { _stateCallback = callback; }
+        { _stateCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the speed command from HA is received.
@@ -166,11 +166,12 @@ public:
      * @note In non-optimistic mode, the speed must be reported back to HA using the HAFan::setSpeed method.
      */
     inline void onSpeedCommand(HAFAN_SPEED_CALLBACK(callback))
-        { _speedCallback = callback; }
+        { _speedCallback = callback; refreshCommandSubscriptions(); }
 
 protected:
     virtual void buildSerializer() override;
     virtual void onMqttConnected() override;
+    virtual void subscribeCommandTopics() override;
     virtual void onMqttMessage(
         const char* topic,
         const uint8_t* payload,
@@ -178,6 +179,9 @@ protected:
     ) override;
 
 private:
+    /// The command topics of the fan (stored in the flash memory).
+    static const CommandEntry Commands[];
+
     /**
      * Publishes the MQTT message with the given state.
      *
@@ -3,8 +3,66 @@
 
 #include "../HAMqtt.h"
 #include "../utils/HAUtils.h"
+#include "../utils/HAKeywords.h"
 #include "../utils/HASerializer.h"
 
+static const HAKeyword FanModeKeywords[] PROGMEM = {
+    {HAFanModeAuto, HAHVAC::AutoFanMode},
+    {HAFanModeLow, HAHVAC::LowFanMode},
+    {HAFanModeMedium, HAHVAC::MediumFanMode},
+    {HAFanModeHigh, HAHVAC::HighFanMode}
+};
+
+static const HAKeyword SwingModeKeywords[] PROGMEM = {
+    {HASwingModeOn, HAHVAC::OnSwingMode},
+    {HASwingModeOff, HAHVAC::OffSwingMode}
+};
+
+static const HAKeyword ModeKeywords[] PROGMEM = {
+    {HAModeAuto, HAHVAC::AutoMode},
+    {HAModeOff, HAHVAC::OffMode},
+    {HAModeCool, HAHVAC::CoolMode},
+    {HAModeHeat, HAHVAC::HeatMode},
+    {HAModeDry, HAHVAC::DryMode},
+    {HAModeFanOnly, HAHVAC::FanOnlyMode}
+};
+
+/**
+ * Replaces items of the array with keywords of the modes that are enabled in the given flags.
+ */
+static void fillModesArray(
+    HASerializerArray* array,
+    const HAKeyword* keywords,
+    const uint8_t keywordsNb,
+    const uint8_t modes
+)
+{
+    array->clear();
+
+    for (uint8_t i = 0; i < keywordsNb; i++) {
+        uint8_t mode;
+        const char* keyword = HAKeywords::getKeyword(keywords, i, mode);
+
+        if (modes & mode) {
+            array->add(keyword);
+        }
+    }
+}
+
+const HABaseDeviceType::CommandEntry HAHVAC::Commands[] PROGMEM = {
+    HACOMMAND(HAAuxCommandTopic, AuxHeatingFeature, HAHVAC, handleAuxStateCommand),
+    HACOMMAND(HAPowerCommandTopic, PowerFeature, HAHVAC, handlePowerCommand),
+    HACOMMAND(HAFanModeCommandTopic, FanFeature, HAHVAC, handleFanModeCommand),
+    HACOMMAND(HASwingModeCommandTopic, SwingFeature, HAHVAC, handleSwingModeCommand),
+    HACOMMAND(HAModeCommandTopic, ModesFeature, HAHVAC, handleModeCommand),
+    HACOMMAND(
+        HATemperatureCommandTopic,
+        TargetTemperatureFeature,
+        HAHVAC,
+        handleTargetTemperatureCommand
+    )
+};
+
 const uint8_t HAHVAC::DefaultFanModes = AutoFanMode | LowFanMode | MediumFanMode | HighFanMode;
 const uint8_t HAHVAC::DefaultSwingModes = OnSwingMode | OffSwingMode;
 const uint8_t HAHVAC::DefaultModes = AutoMode | OffMode | CoolMode | HeatMode | DryMode | FanOnlyMode;
@@ -44,15 +102,15 @@ HAHVAC::HAHVAC(
     _targetTemperatureCallback(nullptr)
 {
     if (_features & FanFeature) {
-        _fanModesSerializer = new HASerializerArray(4);
+        _fanModesSerializer = new HASerializerArray(HAKEYWORDS_NB(FanModeKeywords));
     }
 
     if (_features & SwingFeature) {
-        _swingModesSerializer = new HASerializerArray(2);
+        _swingModesSerializer = new HASerializerArray(HAKEYWORDS_NB(SwingModeKeywords));
     }
 
     if (_features & ModesFeature) {
-        _modesSerializer = new HASerializerArray(6);
+        _modesSerializer = new HASerializerArray(HAKEYWORDS_NB(ModeKeywords));
     }
 }
 
@@ -183,7 +241,11 @@ void HAHVAC::buildSerializer()
         return;
     }
 
-    _serializer = new HASerializer(this, 28); // 28 - max properties nb
+    _serializer = new HASerializer(this, 27); // 27 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -215,23 +277,12 @@ void HAHVAC::buildSerializer()
         _serializer->topic(AHATOFSTR(HAFanModeStateTopic));
 
         if (_fanModes != DefaultFanModes) {
-            _fanModesSerializer->clear();
-
-            if (_fanModes & AutoFanMode) {
-                _fanModesSerializer->add(HAFanModeAuto);
-            }
-
-            if (_fanModes & LowFanMode) {
-                _fanModesSerializer->add(HAFanModeLow);
-            }
-
-            if (_fanModes & MediumFanMode) {
-                _fanModesSerializer->add(HAFanModeMedium);
-            }
-
-            if (_fanModes & HighFanMode) {
-                _fanModesSerializer->add(HAFanModeHigh);
-            }
+            fillModesArray(
+                _fanModesSerializer,
+                FanModeKeywords,
+                HAKEYWORDS_NB(FanModeKeywords),
+                _fanModes
+            );
 
             _serializer->set(
                 AHATOFSTR(HAFanModesProperty),
@@ -246,15 +297,12 @@ void HAHVAC::buildSerializer()
         _serializer->topic(AHATOFSTR(HASwingModeStateTopic));
 
         if (_swingModes != DefaultSwingModes) {
-            _swingModesSerializer->clear();
-
-            if (_swingModes & OnSwingMode) {
-                _swingModesSerializer->add(HASwingModeOn);
-            }
-
-            if (_swingModes & OffSwingMode) {
-                _swingModesSerializer->add(HASwingModeOff);
-            }
+            fillModesArray(
+                _swingModesSerializer,
+                SwingModeKeywords,
+                HAKEYWORDS_NB(SwingModeKeywords),
+                _swingModes
+            );
 
             _serializer->set(
                 AHATOFSTR(HASwingModesProperty),
@@ -269,31 +317,12 @@ void HAHVAC::buildSerializer()
         _serializer->topic(AHATOFSTR(HAModeStateTopic));
 
         if (_modes != DefaultModes) {
-            _modesSerializer->clear();
-
-            if (_modes & AutoMode) {
-                _modesSerializer->add(HAModeAuto);
-            }
-
-            if (_modes & OffMode) {
-                _modesSerializer->add(HAModeOff);
-            }
-
-            if (_modes & CoolMode) {
-                _modesSerializer->add(HAModeCool);
-            }
-
-            if (_modes & HeatMode) {
-                _modesSerializer->add(HAModeHeat);
-            }
-
-            if (_modes & DryMode) {
-                _modesSerializer->add(HAModeDry);
-            }
-
-            if (_modes & FanOnlyMode) {
-                _modesSerializer->add(HAModeFanOnly);
-            }
+            fillModesArray(
+                _modesSerializer,
+                ModeKeywords,
+                HAKEYWORDS_NB(ModeKeywords),
+                _modes
+            );
 
             _serializer->set(
                 AHATOFSTR(HAModesProperty),
@@ -306,11 +335,6 @@ void HAHVAC::buildSerializer()
     if (_features & TargetTemperatureFeature) {
         _serializer->topic(AHATOFSTR(HATemperatureCommandTopic));
         _serializer->topic(AHATOFSTR(HATemperatureStateTopic));
-        _serializer->set(
-            AHATOFSTR(HATemperatureCommandTemplateProperty),
-            getCommandWithFloatTemplate(),
-            HASerializer::ProgmemPropertyValue
-        );
     }
 
     if (_temperatureUnit != DefaultUnit) {
@@ -373,29 +397,23 @@ void HAHVAC::onMqttConnected()
         publishTargetTemperature(_targetTemperature);
     }
 
-    if (_features & AuxHeatingFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HAAuxCommandTopic));
-    }
-
-    if (_features & PowerFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HAPowerCommandTopic));
-    }
-
-    if (_features & FanFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HAFanModeCommandTopic));
-    }
-
-    if (_features & SwingFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HASwingModeCommandTopic));
-    }
-
-    if (_features & ModesFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HAModeCommandTopic));
-    }
+    subscribeCommandTopics();
+}
 
-    if (_features & TargetTemperatureFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HATemperatureCommandTopic));
-    }
+void HAHVAC::subscribeCommandTopics()
+{
+    static_assert(HACOMMANDS_NB(Commands) <= MaxCommandsNb, "Commands don't fit the callbacks' mask");
+
+    // bits follow the order of the commands table
+    const uint8_t callbacks =
+        (_auxCallback ? 1 : 0) |
+        (_powerCallback ? 2 : 0) |
+        (_fanModeCallback ? 4 : 0) |
+        (_swingModeCallback ? 8 : 0) |
+        (_modeCallback ? 16 : 0) |
+        (_targetTemperatureCallback ? 32 : 0);
+
+    subscribeCommands(Commands, HACOMMANDS_NB(Commands), _features, callbacks);
 }
 
 void HAHVAC::onMqttMessage(
@@ -404,43 +422,14 @@ void HAHVAC::onMqttMessage(
     const uint16_t length
 )
 {
-    if (HASerializer::compareDataTopics(
+    dispatchCommand(
+        Commands,
+        HACOMMANDS_NB(Commands),
+        _features,
         topic,
-        uniqueId(),
-        AHATOFSTR(HAAuxCommandTopic)
-    )) {
-        handleAuxStateCommand(payload, length);
-    } else if (HASerializer::compareDataTopics(
-        topic,
-        uniqueId(),
-        AHATOFSTR(HAPowerCommandTopic)
-    )) {
-        handlePowerCommand(payload, length);
-    } else if (HASerializer::compareDataTopics(
-        topic,
-        uniqueId(),
-        AHATOFSTR(HAFanModeCommandTopic)
-    )) {
-        handleFanModeCommand(payload, length);
-    } else if (HASerializer::compareDataTopics(
-        topic,
-        uniqueId(),
-        AHATOFSTR(HASwingModeCommandTopic)
-    )) {
-        handleSwingModeCommand(payload, length);
-    } else if (HASerializer::compareDataTopics(
-        topic,
-        uniqueId(),
-        AHATOFSTR(HAModeCommandTopic)
-    )) {
-        handleModeCommand(payload, length);
-    } else if (HASerializer::compareDataTopics(
-        topic,
-        uniqueId(),
-        AHATOFSTR(HATemperatureCommandTopic)
-    )) {
-        handleTargetTemperatureCommand(payload, length);
-    }
+        payload,
+        length
+    );
 }
 
 bool HAHVAC::publishCurrentTemperature(const HANumeric& temperature)
@@ -449,14 +438,8 @@ bool HAHVAC::publishCurrentTemperature(const HANumeric& temperature)
         return false;
     }
 
-    uint8_t size = temperature.calculateSize();
-    if (size == 0) {
-        return false;
-    }
-
-    char str[size + 1]; // with null terminator
-    str[size] = 0;
-    temperature.toStr(str);
+    char str[HANumeric::MaxStrLength + 1]; // with null terminator
+    str[temperature.toStr(str)] = 0;
 
     return publishOnDataTopic(
         AHATOFSTR(HACurrentTemperatureTopic),
@@ -527,25 +510,12 @@ bool HAHVAC::publishFanMode(const FanMode mode)
         return false;
     }
 
-    const __FlashStringHelper *stateStr = nullptr;
-    switch (mode) {
-    case AutoFanMode:
-        stateStr = AHATOFSTR(HAFanModeAuto);
-        break;
-
-    case LowFanMode:
-        stateStr = AHATOFSTR(HAFanModeLow);
-        break;
-
-    case MediumFanMode:
-        stateStr = AHATOFSTR(HAFanModeMedium);
-        break;
-
-    case HighFanMode:
-        stateStr = AHATOFSTR(HAFanModeHigh);
-        break;
-
-    default:
+    const __FlashStringHelper* stateStr = HAKeywords::encode(
+        FanModeKeywords,
+        HAKEYWORDS_NB(FanModeKeywords),
+        mode
+    );
+    if (!stateStr) {
         return false;
     }
 
@@ -562,17 +532,12 @@ bool HAHVAC::publishSwingMode(const SwingMode mode)
         return false;
     }
 
-    const __FlashStringHelper *stateStr = nullptr;
-    switch (mode) {
-    case OnSwingMode:
-        stateStr = AHATOFSTR(HASwingModeOn);
-        break;
-
-    case OffSwingMode:
-        stateStr = AHATOFSTR(HASwingModeOff);
-        break;
-
-    default:
+    const __FlashStringHelper* stateStr = HAKeywords::encode(
+        SwingModeKeywords,
+        HAKEYWORDS_NB(SwingModeKeywords),
+        mode
+    );
+    if (!stateStr) {
         return false;
     }
 
@@ -589,33 +554,12 @@ bool HAHVAC::publishMode(const Mode mode)
         return false;
     }
 
-    const __FlashStringHelper *stateStr = nullptr;
-    switch (mode) {
-    case AutoMode:
-        stateStr = AHATOFSTR(HAModeAuto);
-        break;
-
-    case OffMode:
-        stateStr = AHATOFSTR(HAModeOff);
-        break;
-
-    case CoolMode:
-        stateStr = AHATOFSTR(HAModeCool);
-        break;
-
-    case HeatMode:
-        stateStr = AHATOFSTR(HAModeHeat);
-        break;
-
-    case DryMode:
-        stateStr = AHATOFSTR(HAModeDry);
-        break;
-
-    case FanOnlyMode:
-        stateStr = AHATOFSTR(HAModeFanOnly);
-        break;
-
-    default:
+    const __FlashStringHelper* stateStr = HAKeywords::encode(
+        ModeKeywords,
+        HAKEYWORDS_NB(ModeKeywords),
+        mode
+    );
+    if (!stateStr) {
         return false;
     }
 
@@ -632,14 +576,8 @@ bool HAHVAC::publishTargetTemperature(const HANumeric& temperature)
         return false;
     }
 
-    uint8_t size = temperature.calculateSize();
-    if (size == 0) {
-        return false;
-    }
-
-    char str[size + 1]; // with null terminator
-    str[size] = 0;
-    temperature.toStr(str);
+    char str[HANumeric::MaxStrLength + 1]; // with null terminator
+    str[temperature.toStr(str)] = 0;
 
     return publishOnDataTopic(
         AHATOFSTR(HATemperatureStateTopic),
@@ -678,14 +616,15 @@ void HAHVAC::handleFanModeCommand(const uint8_t* cmd, const uint16_t length)
         return;
     }
 
-    if (memcmp_P(cmd, HAFanModeAuto, length) == 0) {
-        _fanModeCallback(AutoFanMode, this);
-    } else if (memcmp_P(cmd, HAFanModeLow, length) == 0) {
-        _fanModeCallback(LowFanMode, this);
-    } else if (memcmp_P(cmd, HAFanModeMedium, length) == 0) {
-        _fanModeCallback(MediumFanMode, this);
-    } else if (memcmp_P(cmd, HAFanModeHigh, length) == 0) {
-        _fanModeCallback(HighFanMode, this);
+    uint8_t mode;
+    if (HAKeywords::decode(
+        FanModeKeywords,
+        HAKEYWORDS_NB(FanModeKeywords),
+        cmd,
+        length,
+        mode
+    )) {
+        _fanModeCallback(static_cast<FanMode>(mode), this);
     }
 }
 
@@ -695,10 +634,15 @@ void HAHVAC::handleSwingModeCommand(const uint8_t* cmd, const uint16_t length)
         return;
     }
 
-    if (memcmp_P(cmd, HASwingModeOn, length) == 0) {
-        _swingModeCallback(OnSwingMode, this);
-    } else if (memcmp_P(cmd, HASwingModeOff, length) == 0) {
-        _swingModeCallback(OffSwingMode, this);
+    uint8_t mode;
+    if (HAKeywords::decode(
+        SwingModeKeywords,
+        HAKEYWORDS_NB(SwingModeKeywords),
+        cmd,
+        length,
+        mode
+    )) {
+        _swingModeCallback(static_cast<SwingMode>(mode), this);
     }
 }
 
@@ -708,18 +652,15 @@ void HAHVAC::handleModeCommand(const uint8_t* cmd, const uint16_t length)
         return;
     }
 
-    if (memcmp_P(cmd, HAModeAuto, length) == 0) {
-        _modeCallback(AutoMode, this);
-    } else if (memcmp_P(cmd, HAModeOff, length) == 0) {
-        _modeCallback(OffMode, this);
-    } else if (memcmp_P(cmd, HAModeCool, length) == 0) {
-        _modeCallback(CoolMode, this);
-    } else if (memcmp_P(cmd, HAModeHeat, length) == 0) {
-        _modeCallback(HeatMode, this);
-    }  else if (memcmp_P(cmd, HAModeDry, length) == 0) {
-        _modeCallback(DryMode, this);
-    }  else if (memcmp_P(cmd, HAModeFanOnly, length) == 0) {
-        _modeCallback(FanOnlyMode, this);
+    uint8_t mode;
+    if (HAKeywords::decode(
+        ModeKeywords,
+        HAKEYWORDS_NB(ModeKeywords),
+        cmd,
+        length,
+        mode
+    )) {
+        _modeCallback(static_cast<Mode>(mode), this);
     }
 }
 
@@ -729,28 +670,10 @@ void HAHVAC::handleTargetTemperatureCommand(const uint8_t* cmd, const uint16_t l
         return;
     }
 
-    HANumeric number = HANumeric::fromStr(cmd, length);
+    const HANumeric number = HANumeric::fromStr(cmd, length, _precision);
     if (number.isSet()) {
-        number.setPrecision(_precision);
         _targetTemperatureCallback(number, this);
     }
 }
 
-const __FlashStringHelper* HAHVAC::getCommandWithFloatTemplate()
-{
-    switch (_precision) {
-    case PrecisionP1:
-        return AHATOFSTR(HAValueTemplateFloatP1);
-
-    case PrecisionP2:
-        return AHATOFSTR(HAValueTemplateFloatP2);
-
-    case PrecisionP3:
-        return AHATOFSTR(HAValueTemplateFloatP3);
-
-    default:
-        return nullptr;
-    }
-}
-
 #endif
@@ -447,7 +447,7 @@ public:
      * @note The aux state must be reported back to HA using the HAHVAC::setAuxState method.
      */
     inline void onAuxStateCommand(HAHVAC_CALLBACK_BOOL(callback))
-        { _auxCallback = callback; }
+        { _auxCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the power command from HA is received.
@@ -456,7 +456,7 @@ public:
      * @param callback
      */
     inline void onPowerCommand(HAHVAC_CALLBACK_BOOL(callback))
-        { _powerCallback = callback; }
+        { _powerCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the fan mode command from HA is received.
@@ -466,7 +466,7 @@ public:
      * @note The fan mode must be reported back to HA using the HAHVAC::setFanMode method.
      */
     inline void onFanModeCommand(HAHVAC_CALLBACK_FAN_MODE(callback))
-        { _fanModeCallback = callback; }
+        { _fanModeCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the swing mode command from HA is received.
@@ -476,7 +476,7 @@ public:
      * @note The swing mode must be reported back to HA using the HAHVAC::setSwingMode method.
      */
     inline void onSwingModeCommand(HAHVAC_CALLBACK_SWING_MODE(callback))
-        { _swingModeCallback = callback; }
+        { _swingModeCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the HVAC mode command from HA is received.
@@ -486,7 +486,7 @@ public:
      * @note The mode must be reported back to HA using the HAHVAC::setMode method.
      */
     inline void onModeCommand(HAHVAC_CALLBACK_MODE(callback))
-        { _modeCallback = callback; }
+        { _modeCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the target temperature is set via HA panel.
@@ -496,11 +496,12 @@ public:
      * @note The target temperature must be reported back to HA using the HAHVAC::setTargetTemperature method.
      */
     inline void onTargetTemperatureCommand(HAHVAC_CALLBACK_TARGET_TEMP(callback))
-        { _targetTemperatureCallback = callback; }
+        { _targetTemperatureCallback = callback; refreshCommandSubscriptions(); }
 
 protected:
     virtual void buildSerializer() override;
     virtual void onMqttConnected() override;
+    virtual void subscribeCommandTopics() override;
     virtual void onMqttMessage(
         const char* topic,
         const uint8_t* payload,
@@ -508,6 +509,9 @@ protected:
     ) override;
 
 private:
+    /// The command topics of the HVAC (stored in the flash memory).
+    static const CommandEntry Commands[];
+
     /**
      * Publishes the MQTT message with the given current temperature.
      *
@@ -612,12 +616,6 @@ private:
      */
     void handleTargetTemperatureCommand(const uint8_t* cmd, const uint16_t length);
 
-    /**
-     * Returns progmem string representing value template for the command
-     * that contains floating point numbers.
-     */
-    const __FlashStringHelper* getCommandWithFloatTemplate();
-
     /// Features enabled for the HVAC.
     const uint16_t _features;
 
@@ -4,6 +4,56 @@
 #include "../HAMqtt.h"
 #include "../utils/HASerializer.h"
 
+/// Fields of the light that are referenced by the schema.
+enum LightSerializerField : uint8_t {
+    LightNameField = 0,
+    LightObjectIdField,
+    LightIconField,
+    LightRetainField,
+    LightOptimisticField,
+    LightBrightnessScaleField,
+    LightMinMiredsField,
+    LightMaxMiredsField
+};
+
+/// Schema of the light's configuration.
+static const HASerializer::SchemaEntry LightSchema[] PROGMEM = {
+    HASCHEMA_PROPERTY(HANameProperty, LightNameField, ConstCharPropertyValue),
+    HASCHEMA_PROPERTY(HAObjectIdProperty, LightObjectIdField, ConstCharPropertyValue),
+    HASCHEMA_FLAG(WithUniqueId),
+    HASCHEMA_PROPERTY(HAIconProperty, LightIconField, ConstCharPropertyValue),
+    HASCHEMA_PROPERTY(HARetainProperty, LightRetainField, BoolPropertyType),
+    HASCHEMA_PROPERTY(HAOptimisticProperty, LightOptimisticField, BoolPropertyType),
+    HASCHEMA_FEATURE_TOPIC(HABrightnessStateTopic, HALight::BrightnessFeature),
+    HASCHEMA_FEATURE_TOPIC(HABrightnessCommandTopic, HALight::BrightnessFeature),
+    HASCHEMA_FEATURE_PROPERTY(
+        HABrightnessScaleProperty,
+        LightBrightnessScaleField,
+        NumberPropertyType,
+        HALight::BrightnessFeature
+    ),
+    HASCHEMA_FEATURE_TOPIC(HAColorTemperatureStateTopic, HALight::ColorTemperatureFeature),
+    HASCHEMA_FEATURE_TOPIC(HAColorTemperatureCommandTopic, HALight::ColorTemperatureFeature),
+    HASCHEMA_FEATURE_PROPERTY(
+        HAMinMiredsProperty,
+        LightMinMiredsField,
+        NumberPropertyType,
+        HALight::ColorTemperatureFeature
+    ),
+    HASCHEMA_FEATURE_PROPERTY(
+        HAMaxMiredsProperty,
+        LightMaxMiredsField,
+        NumberPropertyType,
+        HALight::ColorTemperatureFeature
+    ),
+    HASCHEMA_FEATURE_TOPIC(HARGBCommandTopic, HALight::RGBFeature),
+    HASCHEMA_FEATURE_TOPIC(HARGBStateTopic, HALight::RGBFeature),
+    HASCHEMA_FLAG(WithDevice),
+    HASCHEMA_FLAG(WithAvailability),
+    HASCHEMA_TOPIC(HAStateTopic),
+    HASCHEMA_TOPIC(HACommandTopic)
+};
+
 const uint8_t HALight::RGBStringMaxLength = 3*4; // 4 characters per color
 
 void HALight::RGBColor::fromBuffer(const uint8_t* data, const uint16_t length)
@@ -45,6 +95,18 @@ void HALight::RGBColor::fromBuffer(const uint8_t* data, const uint16_t length)
     }
 }
 
+const HABaseDeviceType::CommandEntry HALight::Commands[] PROGMEM = {
+    HACOMMAND(HACommandTopic, 0, HALight, handleStateCommand),
+    HACOMMAND(HABrightnessCommandTopic, BrightnessFeature, HALight, handleBrightnessCommand),
+    HACOMMAND(
+        HAColorTemperatureCommandTopic,
+        ColorTemperatureFeature,
+        HALight,
+        handleColorTemperatureCommand
+    ),
+    HACOMMAND(HARGBCommandTopic, RGBFeature, HALight, handleRGBCommand)
+};
+
 HALight::HALight(const char* uniqueId, const uint8_t features) :
     HABaseDeviceType(AHATOFSTR(HAComponentLight), uniqueId),
     _features(features),
@@ -128,71 +190,44 @@ void HALight::buildSerializer()
         return;
     }
 
-    _serializer = new HASerializer(this, 19); // 19 - max properties nb
-    _serializer->set(AHATOFSTR(HANameProperty), _name);
-    _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
-    _serializer->set(HASerializer::WithUniqueId);
-    _serializer->set(AHATOFSTR(HAIconProperty), _icon);
-
-    if (_retain) {
-        _serializer->set(
-            AHATOFSTR(HARetainProperty),
-            &_retain,
-            HASerializer::BoolPropertyType
-        );
-    }
+    _serializer = new HASerializer(
+        this,
+        LightSchema,
+        sizeof(LightSchema) / sizeof(HASerializer::SchemaEntry),
+        _features
+    );
+}
 
-    if (_optimistic) {
-        _serializer->set(
-            AHATOFSTR(HAOptimisticProperty),
-            &_optimistic,
-            HASerializer::BoolPropertyType
-        );
-    }
+const void* HALight::getSerializerValue(const uint8_t field) const
+{
+    switch (field) {
+    case LightNameField:
+        return _name;
 
-    if (_features & BrightnessFeature) {
-        _serializer->topic(AHATOFSTR(HABrightnessStateTopic));
-        _serializer->topic(AHATOFSTR(HABrightnessCommandTopic));
+    case LightObjectIdField:
+        return _objectId;
 
-        if (_brightnessScale.isSet()) {
-            _serializer->set(
-                AHATOFSTR(HABrightnessScaleProperty),
-                &_brightnessScale,
-                HASerializer::NumberPropertyType
-            );
-        }
-    }
+    case LightIconField:
+        return _icon;
 
-    if (_features & ColorTemperatureFeature) {
-        _serializer->topic(AHATOFSTR(HAColorTemperatureStateTopic));
-        _serializer->topic(AHATOFSTR(HAColorTemperatureCommandTopic));
+    case LightRetainField:
+        return _retain ? &_retain : nullptr;
 
-        if (_minMireds.isSet()) {
-            _serializer->set(
-                AHATOFSTR(HAMinMiredsProperty),
-                &_minMireds,
-                HASerializer::NumberPropertyType
-            );
-        }
+    case LightOptimisticField:
+        return _optimistic ? &_optimistic : nullptr;
 
-        if (_maxMireds.isSet()) {
-            _serializer->set(
-                AHATOFSTR(HAMaxMiredsProperty),
-                &_maxMireds,
-                HASerializer::NumberPropertyType
-            );
-        }
-    }
+    case LightBrightnessScaleField:
+        return _brightnessScale.isSet() ? &_brightnessScale : nullptr;
 
-    if (_features & RGBFeature) {
-        _serializer->topic(AHATOFSTR(HARGBCommandTopic));
-        _serializer->topic(AHATOFSTR(HARGBStateTopic));
-    }
+    case LightMinMiredsField:
+        return _minMireds.isSet() ? &_minMireds : nullptr;
+
+    case LightMaxMiredsField:
+        return _maxMireds.isSet() ? &_maxMireds : nullptr;
 
-    _serializer->set(HASerializer::WithDevice);
-    _serializer->set(HASerializer::WithAvailability);
-    _serializer->topic(AHATOFSTR(HAStateTopic));
-    _serializer->topic(AHATOFSTR(HACommandTopic));
+    default:
+        return nullptr;
+    }
 }
 
 void HALight::onMqttConnected()
@@ -211,19 +246,21 @@ void HALight::onMqttConnected()
         publishRGBColor(_currentRGBColor);
     }
 
-    subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    subscribeCommandTopics();
+}
 
-    if (_features & BrightnessFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HABrightnessCommandTopic));
-    }
+void HALight::subscribeCommandTopics()
+{
+    static_assert(HACOMMANDS_NB(Commands) <= MaxCommandsNb, "Commands don't fit the callbacks' mask");
 
-    if (_features & ColorTemperatureFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HAColorTemperatureCommandTopic));
-    }
+    // bits follow the order of the commands table
+    const uint8_t callbacks =
+        (_stateCallback ? 1 : 0) |
+        (_brightnessCallback ? 2 : 0) |
+        (_colorTemperatureCallback ? 4 : 0) |
+        (_rgbColorCallback ? 8 : 0);
 
-    if (_features & RGBFeature) {
-        subscribeTopic(uniqueId(), AHATOFSTR(HARGBCommandTopic));
-    }
+    subscribeCommands(Commands, HACOMMANDS_NB(Commands), _features, callbacks);
 }
 
 void HALight::onMqttMessage(
@@ -232,33 +269,14 @@ void HALight::onMqttMessage(
     const uint16_t length
 )
 {
-    if (HASerializer::compareDataTopics(
-        topic,
-        uniqueId(),
-        AHATOFSTR(HACommandTopic)
-    )) {
-        handleStateCommand(payload, length);
-    } else if (HASerializer::compareDataTopics(
+    dispatchCommand(
+        Commands,
+        HACOMMANDS_NB(Commands),
+        _features,
         topic,
-        uniqueId(),
-        AHATOFSTR(HABrightnessCommandTopic)
-    )) {
-        handleBrightnessCommand(payload, length);
-    } else if (HASerializer::compareDataTopics(
-        topic,
-        uniqueId(),
-        AHATOFSTR(HAColorTemperatureCommandTopic)
-    )) {
-        handleColorTemperatureCommand(payload, length);
-    } else if (
-        HASerializer::compareDataTopics(
-            topic,
-            uniqueId(),
-            AHATOFSTR(HARGBCommandTopic)
-        )
-    ) {
-        handleRGBCommand(payload, length);
-    }
+        payload,
+        length
+    );
 }
 
 bool HALight::publishState(const bool state)
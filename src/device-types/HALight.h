@@ -265,7 +265,7 @@ public:
      * @note In non-optimistic mode, the state must be reported back to HA using the HALight::setState method.
      */
     inline void onStateCommand(HALIGHT_STATE_CALLBACK(callback))
-        { _stateCallback = callback; }
+        { _stateCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the brightness command from HA is received.
@@ -275,7 +275,7 @@ public:
      * @note In non-optimistic mode, the brightness must be reported back to HA using the HALight::setBrightness method.
      */
     inline void onBrightnessCommand(HALIGHT_BRIGHTNESS_CALLBACK(callback))
-        { _brightnessCallback = callback; }
+        { _brightnessCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the color temperature command from HA is received.
@@ -285,7 +285,7 @@ public:
      * @note In non-optimistic mode, the color temperature must be reported back to HA using the HALight::setColorTemperature method.
      */
     inline void onColorTemperatureCommand(HALIGHT_COLOR_TEMP_CALLBACK(callback))
-        { _colorTemperatureCallback = callback; }
+        { _colorTemperatureCallback = callback; refreshCommandSubscriptions(); }
 
     /**
      * Registers callback that will be called each time the RGB color command from HA is received.
@@ -295,11 +295,13 @@ public:
      * @note In non-optimistic mode, the color must be reported back to HA using the HALight::setRGBColor method.
      */
     inline void onRGBColorCommand(HALIGHT_RGB_COLOR_CALLBACK(callback))
-        { _rgbColorCallback = callback; }
+        { _rgbColorCallback = callback; refreshCommandSubscriptions(); }
 
 protected:
     virtual void buildSerializer() override;
+    virtual const void* getSerializerValue(const uint8_t field) const override;
     virtual void onMqttConnected() override;
+    virtual void subscribeCommandTopics() override;
     virtual void onMqttMessage(
         const char* topic,
         const uint8_t* payload,
@@ -307,6 +309,9 @@ protected:
     ) override;
 
 private:
+    /// The command topics of the light (stored in the flash memory).
+    static const CommandEntry Commands[];
+
     /**
      * Publishes the MQTT message with the given state.
      *
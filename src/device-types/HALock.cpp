@@ -2,8 +2,15 @@
 #ifndef EX_ARDUINOHA_LOCK
 
 #include "../HAMqtt.h"
+#include "../utils/HAKeywords.h"
 #include "../utils/HASerializer.h"
 
+static const HAKeyword CommandKeywords[] PROGMEM = {
+    {HALockCommand, HALock::CommandLock},
+    {HAUnlockCommand, HALock::CommandUnlock},
+    {HAOpenCommand, HALock::CommandOpen}
+};
+
 HALock::HALock(const char* uniqueId) :
     HABaseDeviceType(AHATOFSTR(HAComponentLock), uniqueId),
     _icon(nullptr),
@@ -36,6 +43,10 @@ void HALock::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 10); // 10 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -76,7 +87,14 @@ void HALock::onMqttConnected()
         publishState(_currentState);
     }
 
-    subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    subscribeCommandTopics();
+}
+
+void HALock::subscribeCommandTopics()
+{
+    if (_commandCallback) {
+        subscribeCommand(AHATOFSTR(HACommandTopic));
+    }
 }
 
 void HALock::onMqttMessage(
@@ -113,12 +131,15 @@ void HALock::handleCommand(const uint8_t* cmd, const uint16_t length)
         return;
     }
 
-    if (memcmp_P(cmd, HALockCommand, length) == 0) {
-        _commandCallback(CommandLock, this);
-    } else if (memcmp_P(cmd, HAUnlockCommand, length) == 0) {
-        _commandCallback(CommandUnlock, this);
-    } else if (memcmp_P(cmd, HAOpenCommand, length) == 0) {
-        _commandCallback(CommandOpen, this);
+    uint8_t command;
+    if (HAKeywords::decode(
+        CommandKeywords,
+        HAKEYWORDS_NB(CommandKeywords),
+        cmd,
+        length,
+        command
+    )) {
+        _commandCallback(static_cast<LockCommand>(command), this);
     }
 }
 
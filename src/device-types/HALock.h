@@ -100,11 +100,12 @@ public:
      * @param callback
      */
     inline void onCommand(HALOCK_CALLBACK(callback))
-        { _commandCallback = callback; }
+        { _commandCallback = callback; refreshCommandSubscriptions(); }
 
 protected:
     virtual void buildSerializer() override;
     virtual void onMqttConnected() override;
+    virtual void subscribeCommandTopics() override;
     virtual void onMqttMessage(
         const char* topic,
         const uint8_t* payload,
@@ -2,6 +2,7 @@
 #ifndef EX_ARDUINOHA_NUMBER
 
 #include "../HAMqtt.h"
+#include "../utils/HAKeywords.h"
 #include "../utils/HASerializer.h"
 
 HANumber::HANumber(const char* uniqueId, const NumberPrecision precision) :
@@ -42,7 +43,11 @@ void HANumber::buildSerializer()
         return;
     }
 
-    _serializer = new HASerializer(this, 16); // 16 - max properties nb
+    _serializer = new HASerializer(this, 15); // 15 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -54,11 +59,6 @@ void HANumber::buildSerializer()
         getModeProperty(),
         HASerializer::ProgmemPropertyValue
     );
-    _serializer->set(
-        AHATOFSTR(HACommandTemplateProperty),
-        getCommandTemplate(),
-        HASerializer::ProgmemPropertyValue
-    );
 
     if (_minValue.isSet()) {
         _serializer->set(
@@ -119,7 +119,14 @@ void HANumber::onMqttConnected()
         publishState(_currentState);
     }
 
-    subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    subscribeCommandTopics();
+}
+
+void HANumber::subscribeCommandTopics()
+{
+    if (_commandCallback) {
+        subscribeCommand(AHATOFSTR(HACommandTopic));
+    }
 }
 
 void HANumber::onMqttMessage(
@@ -147,14 +154,8 @@ bool HANumber::publishState(const HANumeric& state)
         );
     }
 
-    const uint8_t size = state.calculateSize();
-    if (size == 0) {
-        return false;
-    }
-
-    char str[size + 1]; // with null terminator
-    str[size] = 0;
-    state.toStr(str);
+    char str[HANumeric::MaxStrLength + 1]; // with null terminator
+    str[state.toStr(str)] = 0;
 
     return publishOnDataTopic(
         AHATOFSTR(HAStateTopic),
@@ -169,12 +170,11 @@ void HANumber::handleCommand(const uint8_t* cmd, const uint16_t length)
         return;
     }
 
-    if (memcmp_P(cmd, HAStateNone, length) == 0) {
+    if (HAKeywords::equals(HAStateNone, cmd, length)) {
         _commandCallback(HANumeric(), this);
     } else {
-        HANumeric number = HANumeric::fromStr(cmd, length);
+        const HANumeric number = HANumeric::fromStr(cmd, length, _precision);
         if (number.isSet()) {
-            number.setPrecision(_precision);
             _commandCallback(number, this);
         }
     }
@@ -194,21 +194,4 @@ const __FlashStringHelper* HANumber::getModeProperty() const
     }
 }
 
-const __FlashStringHelper* HANumber::getCommandTemplate()
-{
-    switch (_precision) {
-    case PrecisionP1:
-        return AHATOFSTR(HAValueTemplateFloatP1);
-
-    case PrecisionP2:
-        return AHATOFSTR(HAValueTemplateFloatP2);
-
-    case PrecisionP3:
-        return AHATOFSTR(HAValueTemplateFloatP3);
-
-    default:
-        return nullptr;
-    }
-}
-
 #endif
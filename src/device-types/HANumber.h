@@ -184,11 +184,12 @@ public:
      * @note In non-optimistic mode, the number must be reported back to HA using the HANumber::setState method.
      */
     inline void onCommand(HANUMBER_CALLBACK(callback))
-        { _commandCallback = callback; }
+        { _commandCallback = callback; refreshCommandSubscriptions(); }
 
 protected:
     virtual void buildSerializer() override;
     virtual void onMqttConnected() override;
+    virtual void subscribeCommandTopics() override;
     virtual void onMqttMessage(
         const char* topic,
         const uint8_t* payload,
@@ -217,11 +218,6 @@ private:
      */
     const __FlashStringHelper* getModeProperty() const;
 
-    /**
-     * Returns progmem string representing value template for the command.
-     */
-    const __FlashStringHelper* getCommandTemplate();
-
     /// The precision of the number. By default it's `HANumber::PrecisionP0`.
     const NumberPrecision _precision;
 
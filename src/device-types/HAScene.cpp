@@ -20,6 +20,10 @@ void HAScene::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 8); // 8 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -53,7 +57,14 @@ void HAScene::onMqttConnected()
 
     publishConfig();
     publishAvailability();
-    subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    subscribeCommandTopics();
+}
+
+void HAScene::subscribeCommandTopics()
+{
+    if (_commandCallback) {
+        subscribeCommand(AHATOFSTR(HACommandTopic));
+    }
 }
 
 void HAScene::onMqttMessage(
@@ -4,9 +4,35 @@
 #include "../HAMqtt.h"
 #include "../utils/HASerializer.h"
 
+/**
+ * Returns the number of slots in the options' hash index (a power of two).
+ * At least half of the slots are always empty, so lookups stay short and always terminate.
+ */
+static uint16_t calculateIndexSize(const uint8_t optionsNb)
+{
+    uint16_t size = 4;
+    while (size < optionsNb * 2) {
+        size <<= 1;
+    }
+
+    return size;
+}
+
+static uint16_t hashOption(const uint8_t* option, const uint16_t length)
+{
+    uint16_t hash = length;
+    for (uint16_t i = 0; i < length; i++) {
+        hash = hash * 31 + option[i];
+    }
+
+    return hash;
+}
+
 HASelect::HASelect(const char* uniqueId) :
     HABaseDeviceType(AHATOFSTR(HAComponentSelect), uniqueId),
     _options(nullptr),
+    _optionsIndex(nullptr),
+    _optionsIndexMask(0),
     _currentState(-1),
     _icon(nullptr),
     _retain(false),
@@ -18,18 +44,8 @@ HASelect::HASelect(const char* uniqueId) :
 
 HASelect::~HASelect()
 {
-    if (_options) {
-        const uint8_t optionsNb = _options->getItemsNb();
-        const HASerializerArray::ItemType* options = _options->getItems();
-
-        if (optionsNb > 1) {
-            for (uint8_t i = 0; i < optionsNb; i++) {
-                delete options[i];
-            }
-        }
-
-        delete _options;
-    }
+    delete _options;
+    delete[] _optionsIndex;
 }
 
 void HASelect::setOptions(const char* options)
@@ -38,31 +54,32 @@ void HASelect::setOptions(const char* options)
         return;
     }
 
-    const uint16_t optionsNb = countOptionsInString(options);
+    const uint8_t optionsNb = countOptionsInString(options);
     if (optionsNb == 0) {
         return;
     }
 
+    const uint16_t indexSize = calculateIndexSize(optionsNb);
     const uint16_t optionsLen = strlen(options) + 1; // include null terminator
-    _options = new HASerializerArray(optionsNb, false);
 
-    if (optionsNb == 1) {
-        _options->add(options);
-        return;
-    }
+    _optionsIndex = new uint8_t[indexSize + optionsLen];
+    _optionsIndexMask = indexSize - 1;
+    memset(_optionsIndex, 0, indexSize);
 
-    uint8_t optionLen = 0;
+    char* optionsCopy = reinterpret_cast<char*>(&_optionsIndex[indexSize]);
+    memcpy(optionsCopy, options, optionsLen);
+
+    _options = new HASerializerArray(optionsNb, false);
+
+    uint16_t optionLen = 0;
     for (uint16_t i = 0; i < optionsLen; i++) {
-        if (options[i] == ';' || options[i] == 0) {
-            if (optionLen == 0) {
+        if (optionsCopy[i] == ';' || optionsCopy[i] == 0) {
+            if (optionLen == 0 || !_options->add(&optionsCopy[i - optionLen])) {
                 break;
             }
 
-            char* option = new char[optionLen + 1]; // including null terminator
-            option[optionLen] = 0;
-            memcpy(option, &options[i - optionLen], optionLen);
-
-            _options->add(option);
+            optionsCopy[i] = 0;
+            indexOption(_options->getItemsNb() - 1);
             optionLen = 0;
             continue;
         }
@@ -87,7 +104,7 @@ bool HASelect::setState(const int8_t state, const bool force)
 
 const char* HASelect::getCurrentOption() const
 {
-    return _options->getItem(getCurrentState());
+    return _options ? _options->getItem(getCurrentState()) : nullptr;
 }
 
 void HASelect::buildSerializer()
@@ -97,6 +114,10 @@ void HASelect::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 11); // 11 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(AHATOFSTR(HANameProperty), _name);
     _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
     _serializer->set(HASerializer::WithUniqueId);
@@ -142,7 +163,14 @@ void HASelect::onMqttConnected()
         publishState(_currentState);
     }
 
-    subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    subscribeCommandTopics();
+}
+
+void HASelect::subscribeCommandTopics()
+{
+    if (_commandCallback) {
+        subscribeCommand(AHATOFSTR(HACommandTopic));
+    }
 }
 
 void HASelect::onMqttMessage(
@@ -151,19 +179,14 @@ void HASelect::onMqttMessage(
     const uint16_t length
 )
 {
-    if (_commandCallback && HASerializer::compareDataTopics(
+    if (_commandCallback && _options && HASerializer::compareDataTopics(
         topic,
         uniqueId(),
         AHATOFSTR(HACommandTopic)
     )) {
-        const uint8_t optionsNb = _options->getItemsNb();
-        const HASerializerArray::ItemType* options = _options->getItems();
-
-        for (uint8_t i = 0; i < optionsNb; i++) {
-            if (memcmp(payload, options[i], length) == 0) {
-                _commandCallback(i, this);
-                return;
-            }
+        const int16_t optionIndex = findOption(payload, length);
+        if (optionIndex >= 0) {
+            _commandCallback(optionIndex, this);
         }
     }
 }
@@ -196,7 +219,7 @@ uint8_t HASelect::countOptionsInString(const char* options) const
         return 0;
     }
 
-    for (uint8_t i = 0; i < optionsLen; i++) {
+    for (uint16_t i = 0; i < optionsLen && optionsNb < UINT8_MAX; i++) {
         if (options[i] == ';') {
             optionsNb++;
         }
@@ -205,4 +228,45 @@ uint8_t HASelect::countOptionsInString(const char* options) const
     return optionsNb;
 }
 
+void HASelect::indexOption(const uint8_t optionIndex)
+{
+    const char* option = _options->getItems()[optionIndex];
+    const uint16_t optionLen = strlen(option);
+    const uint16_t mask = _optionsIndexMask;
+    uint16_t slot = hashOption(
+        reinterpret_cast<const uint8_t*>(option),
+        optionLen
+    ) & mask;
+
+    while (_optionsIndex[slot] != 0) {
+        if (strcmp(_options->getItems()[_optionsIndex[slot] - 1], option) == 0) {
+            return;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    _optionsIndex[slot] = optionIndex + 1;
+}
+
+int16_t HASelect::findOption(const uint8_t* payload, const uint16_t length) const
+{
+    const uint16_t mask = _optionsIndexMask;
+    uint16_t slot = hashOption(payload, length) & mask;
+
+    while (_optionsIndex[slot] != 0) {
+        const uint8_t optionIndex = _optionsIndex[slot] - 1;
+        const char* option = _options->getItems()[optionIndex];
+
+        // the option needs to end exactly where the payload ends, so prefixes don't match
+        if (strlen(option) == length && memcmp(option, payload, length) == 0) {
+            return optionIndex;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return -1;
+}
+
 #endif
@@ -109,7 +109,7 @@ public:
      * @note In non-optimistic mode, the selected option must be reported back to HA using the HASelect::setState method.
      */
     inline void onCommand(HASELECT_CALLBACK(callback))
-        { _commandCallback = callback; }
+        { _commandCallback = callback; refreshCommandSubscriptions(); }
 
 #ifdef ARDUINOHA_TEST
     inline HASerializerArray* getOptions() const
@@ -119,6 +119,7 @@ public:
 protected:
     virtual void buildSerializer() override;
     virtual void onMqttConnected() override;
+    virtual void subscribeCommandTopics() override;
     virtual void onMqttMessage(
         const char* topic,
         const uint8_t* payload,
@@ -136,12 +137,42 @@ private:
 
     /**
      * Counts the amount of options in the given string.
+     * Options above the limit of the serializer's array (255) are not counted.
      */
     uint8_t countOptionsInString(const char* options) const;
 
-    /// Array of options for the serializer.
+    /**
+     * Adds the option to the hash index that's used for resolving commands.
+     * If the same option is already indexed, the index remains unchanged (the first option wins).
+     *
+     * @param optionIndex The index of the option.
+     */
+    void indexOption(const uint8_t optionIndex);
+
+    /**
+     * Returns index of the option that's equal to the given payload.
+     * If there is no such option, `-1` is returned.
+     *
+     * @param payload The command's payload.
+     * @param length The length of the payload.
+     */
+    int16_t findOption(const uint8_t* payload, const uint16_t length) const;
+
+    /// Array of options for the serializer. Items point to the `_optionsIndex` buffer.
     HASerializerArray* _options;
 
+    /**
+     * The open addressing hash index of the options (an option's index + 1 per slot, `0` for empty slots),
+     * followed by the null-terminated options. Everything is allocated as a single buffer.
+     */
+    uint8_t* _optionsIndex;
+
+    /**
+     * The mask of slots in the `_optionsIndex` (the number of slots - 1).
+     * The index is sized for the options found in the string, which may differ from the number of parsed options.
+     */
+    uint16_t _optionsIndexMask;
+
     /// Stores the current state (the current option's index). By default it's `-1`.
     int8_t _currentState;
 
@@ -4,6 +4,35 @@
 #include "../HAMqtt.h"
 #include "../utils/HASerializer.h"
 
+/// Fields of the sensor that are referenced by the schema.
+enum SensorSerializerField : uint8_t {
+    SensorNameField = 0,
+    SensorObjectIdField,
+    SensorDeviceClassField,
+    SensorStateClassField,
+    SensorIconField,
+    SensorUnitOfMeasurementField,
+    SensorForceUpdateField,
+    SensorExpireAfterField
+};
+
+/// Schema of the sensor's configuration.
+static const HASerializer::SchemaEntry SensorSchema[] PROGMEM = {
+    HASCHEMA_PROPERTY(HANameProperty, SensorNameField, ConstCharPropertyValue),
+    HASCHEMA_PROPERTY(HAObjectIdProperty, SensorObjectIdField, ConstCharPropertyValue),
+    HASCHEMA_FLAG(WithUniqueId),
+    HASCHEMA_PROPERTY(HADeviceClassProperty, SensorDeviceClassField, ConstCharPropertyValue),
+    HASCHEMA_PROPERTY(HAStateClassProperty, SensorStateClassField, ConstCharPropertyValue),
+    HASCHEMA_PROPERTY(HAIconProperty, SensorIconField, ConstCharPropertyValue),
+    HASCHEMA_PROPERTY(HAUnitOfMeasurementProperty, SensorUnitOfMeasurementField, ConstCharPropertyValue),
+    HASCHEMA_PROPERTY(HAForceUpdateProperty, SensorForceUpdateField, BoolPropertyType),
+    HASCHEMA_PROPERTY(HAExpireAfterProperty, SensorExpireAfterField, NumberPropertyType),
+    HASCHEMA_FEATURE_TOPIC(HAJsonAttributesTopic, HASensor::JsonAttributesFeature),
+    HASCHEMA_FLAG(WithDevice),
+    HASCHEMA_FLAG(WithAvailability),
+    HASCHEMA_TOPIC(HAStateTopic)
+};
+
 HASensor::HASensor(const char* uniqueId, const uint16_t features) :
     HABaseDeviceType(AHATOFSTR(HAComponentSensor), uniqueId),
     _features(features),
@@ -46,38 +75,44 @@ void HASensor::buildSerializer()
         return;
     }
 
-    _serializer = new HASerializer(this, 13); // 13 - max properties nb
-    _serializer->set(AHATOFSTR(HANameProperty), _name);
-    _serializer->set(AHATOFSTR(HAObjectIdProperty), _objectId);
-    _serializer->set(HASerializer::WithUniqueId);
-    _serializer->set(AHATOFSTR(HADeviceClassProperty), _deviceClass);
-    _serializer->set(AHATOFSTR(HAStateClassProperty), _stateClass);
-    _serializer->set(AHATOFSTR(HAIconProperty), _icon);
-    _serializer->set(AHATOFSTR(HAUnitOfMeasurementProperty), _unitOfMeasurement);
-
-    if (_forceUpdate) {
-        _serializer->set(
-            AHATOFSTR(HAForceUpdateProperty),
-            &_forceUpdate,
-            HASerializer::BoolPropertyType
-        );
-    }
+    _serializer = new HASerializer(
+        this,
+        SensorSchema,
+        sizeof(SensorSchema) / sizeof(HASerializer::SchemaEntry),
+        _features
+    );
+}
 
-    if (_expireAfter.isSet()) {
-        _serializer->set(
-            AHATOFSTR(HAExpireAfterProperty),
-            &_expireAfter,
-            HASerializer::NumberPropertyType
-        );
-    }
+const void* HASensor::getSerializerValue(const uint8_t field) const
+{
+    switch (field) {
+    case SensorNameField:
+        return _name;
 
-    if (_features & JsonAttributesFeature) {
-        _serializer->topic(AHATOFSTR(HAJsonAttributesTopic));
-    }
+    case SensorObjectIdField:
+        return _objectId;
+
+    case SensorDeviceClassField:
+        return _deviceClass;
 
-    _serializer->set(HASerializer::WithDevice);
-    _serializer->set(HASerializer::WithAvailability);
-    _serializer->topic(AHATOFSTR(HAStateTopic));
+    case SensorStateClassField:
+        return _stateClass;
+
+    case SensorIconField:
+        return _icon;
+
+    case SensorUnitOfMeasurementField:
+        return _unitOfMeasurement;
+
+    case SensorForceUpdateField:
+        return _forceUpdate ? &_forceUpdate : nullptr;
+
+    case SensorExpireAfterField:
+        return _expireAfter.isSet() ? &_expireAfter : nullptr;
+
+    default:
+        return nullptr;
+    }
 }
 
 void HASensor::onMqttConnected()
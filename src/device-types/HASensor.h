@@ -101,6 +101,7 @@ public:
 
 protected:
     virtual void buildSerializer() override final;
+    virtual const void* getSerializerValue(const uint8_t field) const override;
     virtual void onMqttConnected() override;
 
 private:
@@ -49,14 +49,8 @@ bool HASensorNumber::publishValue(const HANumeric& value)
         return false;
     }
 
-    uint8_t size = value.calculateSize();
-    if (size == 0) {
-        return false;
-    }
-
-    char str[size + 1]; // with null terminator
-    str[size] = 0;
-    value.toStr(str);
+    char str[HANumeric::MaxStrLength + 1]; // with null terminator
+    str[value.toStr(str)] = 0;
 
     return publishOnDataTopic(
         AHATOFSTR(HAStateTopic),
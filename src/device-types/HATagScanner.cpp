@@ -26,6 +26,10 @@ void HATagScanner::buildSerializer()
     }
 
     _serializer = new HASerializer(this, 2); // 2 - max properties nb
+    if (!_serializer) {
+        return; // the shared serializer is in use (static memory mode)
+    }
+
     _serializer->set(HASerializer::WithDevice);
     _serializer->topic(AHATOFSTR(HATopic));
 }
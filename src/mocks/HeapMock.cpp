@@ -0,0 +1,95 @@
+#include "HeapMock.h"
+#ifdef ARDUINOHA_TEST
+
+#include "../HAMqtt.h"
+
+uint8_t HeapMock::_suspendedNb = 0;
+
+void HeapMock::suspendTracking()
+{
+    _suspendedNb++;
+}
+
+void HeapMock::resumeTracking()
+{
+    if (_suspendedNb > 0) {
+        _suspendedNb--;
+    }
+}
+
+bool HeapMock::isTrackingEnabled()
+{
+    return _suspendedNb == 0;
+}
+
+#ifdef ARDUINOHA_ALLOCATION_STATS
+
+#include <new>
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * Header stored in front of each allocated block.
+ * It's aligned to the largest fundamental alignment, so the block itself stays aligned.
+ */
+struct alignas(alignof(max_align_t)) HeapMockBlock
+{
+    size_t size;
+    bool tracked;
+};
+
+void* operator new(size_t size)
+{
+    HeapMockBlock* block = static_cast<HeapMockBlock*>(
+        malloc(sizeof(HeapMockBlock) + size)
+    );
+    if (!block) {
+        throw std::bad_alloc();
+    }
+
+    block->size = size;
+    block->tracked = HeapMock::isTrackingEnabled() && HAMqtt::instance() != nullptr;
+
+    if (block->tracked) {
+        HAMqtt::instance()->trackAllocation(size);
+    }
+
+    return block + 1;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (!ptr) {
+        return;
+    }
+
+    HeapMockBlock* block = static_cast<HeapMockBlock*>(ptr) - 1;
+    if (block->tracked && HAMqtt::instance() != nullptr) {
+        HAMqtt::instance()->trackDeallocation(block->size);
+    }
+
+    free(block);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
+#endif
+#endif
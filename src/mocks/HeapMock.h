@@ -0,0 +1,38 @@
+#ifndef AHA_HEAPMOCK_H
+#define AHA_HEAPMOCK_H
+
+#ifdef ARDUINOHA_TEST
+
+#include <Arduino.h>
+
+/**
+ * Host implementation of the allocation tracking.
+ * If the `ARDUINOHA_ALLOCATION_STATS` macro is defined, the global `new` and `delete` operators
+ * are replaced and each allocation is reported to the HAMqtt instance (see HAMqtt::getAllocationStats).
+ * Allocations made by the mocks are excluded from the statistics.
+ */
+class HeapMock
+{
+public:
+    /**
+     * Stops tracking of the allocations until HeapMock::resumeTracking is called.
+     * Calls can be nested.
+     */
+    static void suspendTracking();
+
+    /**
+     * Resumes tracking of the allocations.
+     */
+    static void resumeTracking();
+
+    /**
+     * Returns true if the allocations are currently tracked.
+     */
+    static bool isTrackingEnabled();
+
+private:
+    static uint8_t _suspendedNb;
+};
+
+#endif
+#endif
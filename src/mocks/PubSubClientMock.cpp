@@ -2,6 +2,7 @@
 #ifdef ARDUINOHA_TEST
 
 #include "../ArduinoHADefines.h"
+#include "HeapMock.h"
 
 PubSubClientMock::PubSubClientMock() :
     _pendingMessage(nullptr),
@@ -10,8 +11,12 @@ PubSubClientMock::PubSubClientMock() :
     _bufferSize(256),
     _state(-1),
     _flushedMessagesNb(0),
+    _writesNb(0),
     _subscriptions(nullptr),
     _subscriptionsNb(0),
+    _subscribePacketsNb(0),
+    _malformedPacketsNb(0),
+    _lastPacketId(0),
     callback(nullptr)
 {
 
@@ -117,6 +122,8 @@ bool PubSubClientMock::beginPublish(
         return false;
     }
 
+    HeapMock::suspendTracking();
+
     if (_pendingMessage) {
         delete _pendingMessage;
     }
@@ -141,15 +148,21 @@ bool PubSubClientMock::beginPublish(
         memset(_pendingMessage->buffer, 0, size);
     }
 
+    HeapMock::resumeTracking();
     return true;
 }
 
 size_t PubSubClientMock::write(const uint8_t *buffer, size_t size)
 {
-    if (!_pendingMessage || !_pendingMessage->buffer) {
+    if (!_pendingMessage) {
+        return writePacket(buffer, size);
+    }
+
+    if (!_pendingMessage->buffer) {
         return 0;
     }
 
+    _writesNb++;
     strncat(_pendingMessage->buffer, (const char*)buffer, size);
     return size;
 }
@@ -184,6 +197,84 @@ int PubSubClientMock::endPublish()
 }
 
 bool PubSubClientMock::subscribe(const char* topic)
+{
+    _subscribePacketsNb++;
+    addSubscription(topic, strlen(topic));
+    return true;
+}
+
+size_t PubSubClientMock::writePacket(const uint8_t* buffer, size_t size)
+{
+    // fixed header: packet type with flags and the remaining length (variable byte integer)
+    if (!connected() || size < 2 || buffer[0] != 0x82) {
+        _malformedPacketsNb++;
+        return 0;
+    }
+
+    size_t remainingLength = 0;
+    size_t position = 1;
+    uint8_t shift = 0;
+
+    while (true) {
+        if (position >= size || shift > 21) {
+            _malformedPacketsNb++;
+            return 0;
+        }
+
+        const uint8_t digit = buffer[position++];
+        remainingLength |= (size_t)(digit & 0x7F) << shift;
+        shift += 7;
+
+        if ((digit & 0x80) == 0) {
+            break;
+        }
+    }
+
+    // packet identifier followed by at least one topic filter
+    if (remainingLength != size - position || remainingLength < 2 + 3) {
+        _malformedPacketsNb++;
+        return 0;
+    }
+
+    const uint16_t packetId = (buffer[position] << 8) | buffer[position + 1];
+    if (packetId == 0) {
+        _malformedPacketsNb++;
+        return 0;
+    }
+
+    // validate all entries before registering subscriptions
+    const size_t payloadStart = position + 2;
+    position = payloadStart;
+
+    while (position < size) {
+        if (size - position < 3) {
+            _malformedPacketsNb++;
+            return 0;
+        }
+
+        const uint16_t topicLength = (buffer[position] << 8) | buffer[position + 1];
+        const size_t qosPosition = position + 2 + topicLength;
+        if (topicLength == 0 || qosPosition >= size || buffer[qosPosition] > 2) {
+            _malformedPacketsNb++;
+            return 0;
+        }
+
+        position = qosPosition + 1;
+    }
+
+    position = payloadStart;
+    while (position < size) {
+        const uint16_t topicLength = (buffer[position] << 8) | buffer[position + 1];
+        addSubscription(reinterpret_cast<const char*>(&buffer[position + 2]), topicLength);
+        position += 2 + topicLength + 1;
+    }
+
+    _subscribePacketsNb++;
+    _lastPacketId = packetId;
+    return size;
+}
+
+void PubSubClientMock::addSubscription(const char* topic, size_t length)
 {
     uint8_t index = _subscriptionsNb;
 
@@ -192,13 +283,14 @@ bool PubSubClientMock::subscribe(const char* topic)
         realloc(_subscriptions, _subscriptionsNb * sizeof(MqttSubscription*))
     );
 
-    size_t topicSize = strlen(topic) + 1;
+    HeapMock::suspendTracking();
     MqttSubscription* subscription = new MqttSubscription();
-    subscription->topic = new char[topicSize];
-    memcpy(subscription->topic, topic, topicSize);
+    subscription->topic = new char[length + 1];
+    HeapMock::resumeTracking();
+    memcpy(subscription->topic, topic, length);
+    subscription->topic[length] = 0;
 
     _subscriptions[index] = subscription;
-    return true;
 }
 
 void PubSubClientMock::clearFlushedMessages()
@@ -208,10 +300,12 @@ void PubSubClientMock::clearFlushedMessages()
             delete _flushedMessages[i];
         }
 
-        delete _flushedMessages;
+        free(_flushedMessages);
+        _flushedMessages = nullptr;
     }
 
     _flushedMessagesNb = 0;
+    _writesNb = 0;
 }
 
 void PubSubClientMock::clearSubscriptions()
@@ -221,10 +315,13 @@ void PubSubClientMock::clearSubscriptions()
             delete _subscriptions[i];
         }
 
-        delete _subscriptions;
+        free(_subscriptions);
+        _subscriptions = nullptr;
     }
 
     _subscriptionsNb = 0;
+    _subscribePacketsNb = 0;
+    _malformedPacketsNb = 0;
 }
 
 void PubSubClientMock::fakeMessage(const char* topic, const char* message)
@@ -151,12 +151,24 @@ public:
     inline MqttMessage** getFlushedMessages() const
         { return _flushedMessages; }
 
+    inline uint16_t getWritesNb() const
+        { return _writesNb; }
+
     inline uint8_t getSubscriptionsNb() const
         { return _subscriptionsNb; }
 
     inline MqttSubscription** getSubscriptions() const
         { return _subscriptions; }
 
+    inline uint8_t getSubscribePacketsNb() const
+        { return _subscribePacketsNb; }
+
+    inline uint8_t getMalformedPacketsNb() const
+        { return _malformedPacketsNb; }
+
+    inline uint16_t getLastPacketId() const
+        { return _lastPacketId; }
+
     inline const MqttConnection& getConnection() const
         { return _connection; }
 
@@ -170,14 +182,26 @@ public:
     void fakeMessage(const __FlashStringHelper* topic, const __FlashStringHelper* message);
 
 private:
+    /**
+     * Parses the raw SUBSCRIBE packet written outside of the publish.
+     * Each topic filter of the valid packet is added to the subscriptions.
+     * The packet is counted as malformed if its layout doesn't match MQTT 3.1.1.
+     */
+    size_t writePacket(const uint8_t* buffer, size_t size);
+    void addSubscription(const char* topic, size_t length);
+
     MqttMessage* _pendingMessage;
     MqttMessage** _flushedMessages;
     uint16_t _keepAlive;
     uint16_t _bufferSize;
     int16_t _state;
     uint8_t _flushedMessagesNb;
+    uint16_t _writesNb;
     MqttSubscription** _subscriptions;
     uint8_t _subscriptionsNb;
+    uint8_t _subscribePacketsNb;
+    uint8_t _malformedPacketsNb;
+    uint16_t _lastPacketId;
     MqttConnection _connection;
     MqttWill _lastWill;
     MQTT_CALLBACK_SIGNATURE;
@@ -18,6 +18,7 @@ const char HAComponentScene[] PROGMEM = {"scene"};
 const char HAComponentFan[] PROGMEM = {"fan"};
 const char HAComponentLight[] PROGMEM = {"light"};
 const char HAComponentClimate[] PROGMEM = {"climate"};
+const char HAComponentDevice[] PROGMEM = {"device"};
 
 // decorators
 const char HASerializerSlash[] PROGMEM = {"/"};
@@ -30,6 +31,9 @@ const char HASerializerJsonPropertiesSeparator[] PROGMEM = {","};
 const char HASerializerJsonArrayPrefix[] PROGMEM = {"["};
 const char HASerializerJsonArraySuffix[] PROGMEM = {"]"};
 const char HASerializerUnderscore[] PROGMEM = {"_"};
+const char HASerializerBaseTopicPrefix[] PROGMEM = {"~/"};
+const char HASerializerEmpty[] PROGMEM = {""};
+const char HASerializerWildcard[] PROGMEM = {"+"};
 
 // properties
 const char HADeviceIdentifiersProperty[] PROGMEM = {"ids"};
@@ -41,6 +45,10 @@ const char HANameProperty[] PROGMEM = {"name"};
 const char HAUniqueIdProperty[] PROGMEM = {"uniq_id"};
 const char HAObjectIdProperty[] PROGMEM = {"obj_id"};
 const char HADeviceProperty[] PROGMEM = {"dev"};
+const char HABaseTopicProperty[] PROGMEM = {"~"};
+const char HAPlatformProperty[] PROGMEM = {"p"};
+const char HAOriginProperty[] PROGMEM = {"o"};
+const char HAComponentsProperty[] PROGMEM = {"cmps"};
 const char HADeviceClassProperty[] PROGMEM = {"dev_cla"};
 const char HAStateClassProperty[] PROGMEM = {"stat_cla"};
 const char HAIconProperty[] PROGMEM = {"ic"};
@@ -105,8 +113,10 @@ const char HATemperatureStateTopic[] PROGMEM = {"temp_stat_t"};
 const char HARGBCommandTopic[] PROGMEM = {"rgb_cmd_t"};
 const char HARGBStateTopic[] PROGMEM = {"rgb_stat_t"};
 const char HAJsonAttributesTopic[] PROGMEM = {"json_attr_t"};
+const char HAStatusTopic[] PROGMEM = {"status"};
 
 // misc
+const char HAOriginName[] PROGMEM = {"ArduinoHA"};
 const char HAOnline[] PROGMEM = {"online"};
 const char HAOffline[] PROGMEM = {"offline"};
 const char HAStateOn[] PROGMEM = {"ON"};
@@ -193,8 +203,13 @@ const char HAModeFanOnly[] PROGMEM = {"fan_only"};
 const char HAHexMap[] PROGMEM = {"0123456789abcdef"};
 
 // value templates
-const char HAValueTemplateFloatP1[] PROGMEM = {"{{int(float(value)*10**1)}}"};
-const char HAValueTemplateFloatP2[] PROGMEM = {"{{int(float(value)*10**2)}}"};
-const char HAValueTemplateFloatP3[] PROGMEM = {"{{int(float(value)*10**3)}}"};
 const char HATemperatureUnitC[] PROGMEM = {"C"};
 const char HATemperatureUnitF[] PROGMEM = {"F"};
+
+// serializer keys
+#define HASERIALIZER_KEY_POINTER(name) name,
+
+const char* const HASerializerKeys[] PROGMEM = {
+    nullptr,
+    HASERIALIZER_KEYS(HASERIALIZER_KEY_POINTER)
+};
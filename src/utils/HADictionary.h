@@ -1,6 +1,8 @@
 #ifndef AHA_HADICTIONARY_H
 #define AHA_HADICTIONARY_H
 
+#include <stdint.h>
+
 // components
 extern const char HAComponentBinarySensor[];
 extern const char HAComponentButton[];
@@ -18,6 +20,7 @@ extern const char HAComponentScene[];
 extern const char HAComponentFan[];
 extern const char HAComponentLight[];
 extern const char HAComponentClimate[];
+extern const char HAComponentDevice[];
 
 // decorators
 extern const char HASerializerSlash[];
@@ -30,6 +33,9 @@ extern const char HASerializerJsonPropertiesSeparator[];
 extern const char HASerializerJsonArrayPrefix[];
 extern const char HASerializerJsonArraySuffix[];
 extern const char HASerializerUnderscore[];
+extern const char HASerializerBaseTopicPrefix[];
+extern const char HASerializerEmpty[];
+extern const char HASerializerWildcard[];
 
 // properties
 extern const char HADeviceIdentifiersProperty[];
@@ -41,6 +47,10 @@ extern const char HANameProperty[];
 extern const char HAUniqueIdProperty[];
 extern const char HAObjectIdProperty[];
 extern const char HADeviceProperty[];
+extern const char HABaseTopicProperty[];
+extern const char HAPlatformProperty[];
+extern const char HAOriginProperty[];
+extern const char HAComponentsProperty[];
 extern const char HADeviceClassProperty[];
 extern const char HAStateClassProperty[];
 extern const char HAIconProperty[];
@@ -105,8 +115,10 @@ extern const char HATemperatureStateTopic[];
 extern const char HARGBCommandTopic[];
 extern const char HARGBStateTopic[];
 extern const char HAJsonAttributesTopic[];
+extern const char HAStatusTopic[];
 
 // misc
+extern const char HAOriginName[];
 extern const char HAOnline[];
 extern const char HAOffline[];
 extern const char HAStateOn[];
@@ -193,10 +205,97 @@ extern const char HAModeFanOnly[];
 extern const char HAHexMap[];
 
 // value templates
-extern const char HAValueTemplateFloatP1[];
-extern const char HAValueTemplateFloatP2[];
-extern const char HAValueTemplateFloatP3[];
 extern const char HATemperatureUnitC[];
 extern const char HATemperatureUnitF[];
 
+// serializer keys (properties and topics addressable by an 8-bit index)
+#define HASERIALIZER_KEYS(KEY) \
+    KEY(HADeviceIdentifiersProperty) \
+    KEY(HADeviceManufacturerProperty) \
+    KEY(HADeviceModelProperty) \
+    KEY(HADeviceSoftwareVersionProperty) \
+    KEY(HADeviceConfigurationUrlProperty) \
+    KEY(HANameProperty) \
+    KEY(HAUniqueIdProperty) \
+    KEY(HAObjectIdProperty) \
+    KEY(HADeviceProperty) \
+    KEY(HABaseTopicProperty) \
+    KEY(HAPlatformProperty) \
+    KEY(HAOriginProperty) \
+    KEY(HAComponentsProperty) \
+    KEY(HADeviceClassProperty) \
+    KEY(HAStateClassProperty) \
+    KEY(HAIconProperty) \
+    KEY(HARetainProperty) \
+    KEY(HASourceTypeProperty) \
+    KEY(HAEncodingProperty) \
+    KEY(HAOptimisticProperty) \
+    KEY(HAAutomationTypeProperty) \
+    KEY(HATypeProperty) \
+    KEY(HASubtypeProperty) \
+    KEY(HAForceUpdateProperty) \
+    KEY(HAUnitOfMeasurementProperty) \
+    KEY(HAValueTemplateProperty) \
+    KEY(HAOptionsProperty) \
+    KEY(HAMinProperty) \
+    KEY(HAMaxProperty) \
+    KEY(HAStepProperty) \
+    KEY(HAModeProperty) \
+    KEY(HACommandTemplateProperty) \
+    KEY(HASpeedRangeMaxProperty) \
+    KEY(HASpeedRangeMinProperty) \
+    KEY(HABrightnessScaleProperty) \
+    KEY(HAMinMiredsProperty) \
+    KEY(HAMaxMiredsProperty) \
+    KEY(HATemperatureUnitProperty) \
+    KEY(HAMinTempProperty) \
+    KEY(HAMaxTempProperty) \
+    KEY(HATempStepProperty) \
+    KEY(HAFanModesProperty) \
+    KEY(HASwingModesProperty) \
+    KEY(HAModesProperty) \
+    KEY(HATemperatureCommandTemplateProperty) \
+    KEY(HAPayloadOnProperty) \
+    KEY(HAExpireAfterProperty) \
+    KEY(HAConfigTopic) \
+    KEY(HAAvailabilityTopic) \
+    KEY(HATopic) \
+    KEY(HAStateTopic) \
+    KEY(HACommandTopic) \
+    KEY(HAPositionTopic) \
+    KEY(HAPercentageStateTopic) \
+    KEY(HAPercentageCommandTopic) \
+    KEY(HABrightnessCommandTopic) \
+    KEY(HABrightnessStateTopic) \
+    KEY(HAColorTemperatureCommandTopic) \
+    KEY(HAColorTemperatureStateTopic) \
+    KEY(HACurrentTemperatureTopic) \
+    KEY(HAActionTopic) \
+    KEY(HAAuxCommandTopic) \
+    KEY(HAAuxStateTopic) \
+    KEY(HAPowerCommandTopic) \
+    KEY(HAFanModeCommandTopic) \
+    KEY(HAFanModeStateTopic) \
+    KEY(HASwingModeCommandTopic) \
+    KEY(HASwingModeStateTopic) \
+    KEY(HAModeCommandTopic) \
+    KEY(HAModeStateTopic) \
+    KEY(HATemperatureCommandTopic) \
+    KEY(HATemperatureStateTopic) \
+    KEY(HARGBCommandTopic) \
+    KEY(HARGBStateTopic) \
+    KEY(HAJsonAttributesTopic) \
+    KEY(HAStatusTopic)
+
+#define HASERIALIZER_KEY_INDEX(name) name##Key,
+
+/// Indices of the properties and topics in the `HASerializerKeys` table (e.g. `HANamePropertyKey`).
+enum HASerializerKey : uint8_t {
+    HANoKey = 0,
+    HASERIALIZER_KEYS(HASERIALIZER_KEY_INDEX)
+    HASerializerKeysNb
+};
+
+extern const char* const HASerializerKeys[];
+
 #endif
@@ -0,0 +1,83 @@
+#include <Arduino.h>
+
+#include "HAKeywords.h"
+#include "../ArduinoHADefines.h"
+
+#ifndef pgm_read_ptr
+#define pgm_read_ptr(addr) (*(const void* const*)(addr))
+#endif
+
+bool HAKeywords::decode(
+    const HAKeyword* keywords,
+    const uint8_t keywordsNb,
+    const uint8_t* payload,
+    const uint16_t length,
+    uint8_t& value
+)
+{
+    if (!payload || length == 0) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < keywordsNb; i++) {
+        const char* keyword = getKeyword(keywords, i, value);
+
+        // keywords of the same table rarely share the first character
+        if (
+            static_cast<uint8_t>(pgm_read_byte(keyword)) == payload[0] &&
+            equals(keyword, payload, length)
+        ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const __FlashStringHelper* HAKeywords::encode(
+    const HAKeyword* keywords,
+    const uint8_t keywordsNb,
+    const uint8_t value
+)
+{
+    for (uint8_t i = 0; i < keywordsNb; i++) {
+        uint8_t keywordValue;
+        const char* keyword = getKeyword(keywords, i, keywordValue);
+
+        if (keywordValue == value) {
+            return AHATOFSTR(keyword);
+        }
+    }
+
+    return nullptr;
+}
+
+const char* HAKeywords::getKeyword(
+    const HAKeyword* keywords,
+    const uint8_t index,
+    uint8_t& value
+)
+{
+    value = pgm_read_byte(&keywords[index].value);
+    return static_cast<const char*>(pgm_read_ptr(&keywords[index].keyword));
+}
+
+bool HAKeywords::equals(
+    const char* keyword,
+    const uint8_t* payload,
+    const uint16_t length
+)
+{
+    if (!keyword || !payload) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < length; i++) {
+        const uint8_t ch = pgm_read_byte(&keyword[i]);
+        if (ch == 0 || ch != payload[i]) {
+            return false;
+        }
+    }
+
+    return pgm_read_byte(&keyword[length]) == 0;
+}
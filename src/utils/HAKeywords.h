@@ -0,0 +1,91 @@
+#ifndef AHA_HAKEYWORDS_H
+#define AHA_HAKEYWORDS_H
+
+#include <Arduino.h>
+
+/// Returns the number of keywords in the given table.
+#define HAKEYWORDS_NB(keywords) static_cast<uint8_t>(sizeof(keywords) / sizeof(HAKeyword))
+
+/**
+ * Maps the keyword (e.g. `auto` mode of the HVAC) to the value of the device type's enum.
+ * Both, the keyword and the table of keywords, are stored in the flash memory.
+ */
+struct HAKeyword
+{
+    /// Pointer to the keyword in the flash memory.
+    const char* keyword;
+
+    /// The enum's value represented by the keyword.
+    uint8_t value;
+};
+
+/**
+ * HAKeywords converts the MQTT payloads to the enum values and vice versa
+ * using the flash-resident tables of keywords.
+ */
+class HAKeywords
+{
+public:
+    /**
+     * Finds the keyword that's exactly equal to the given payload.
+     * Keywords are filtered by the first character, so only the matching keyword is compared in full.
+     *
+     * @param keywords The table of keywords stored in the flash memory.
+     * @param keywordsNb The number of keywords in the table.
+     * @param payload The payload to decode.
+     * @param length The length of the payload.
+     * @param value The enum's value of the matching keyword (output).
+     * @returns Returns `true` if the matching keyword has been found.
+     */
+    static bool decode(
+        const HAKeyword* keywords,
+        const uint8_t keywordsNb,
+        const uint8_t* payload,
+        const uint16_t length,
+        uint8_t& value
+    );
+
+    /**
+     * Returns the keyword that represents the given enum's value.
+     * If the value is not present in the table, nullptr is returned.
+     *
+     * @param keywords The table of keywords stored in the flash memory.
+     * @param keywordsNb The number of keywords in the table.
+     * @param value The enum's value to encode.
+     */
+    static const __FlashStringHelper* encode(
+        const HAKeyword* keywords,
+        const uint8_t keywordsNb,
+        const uint8_t value
+    );
+
+    /**
+     * Returns the keyword stored at the given index of the table.
+     *
+     * @param keywords The table of keywords stored in the flash memory.
+     * @param index The index of the keyword.
+     * @param value The enum's value of the keyword (output).
+     */
+    static const char* getKeyword(
+        const HAKeyword* keywords,
+        const uint8_t index,
+        uint8_t& value
+    );
+
+    /**
+     * Compares the payload with the keyword stored in the flash memory.
+     * Contrary to `memcmp_P`, the payload needs to have exactly the same length as the keyword
+     * and the keyword is never read beyond its null terminator.
+     *
+     * @param keyword The keyword stored in the flash memory.
+     * @param payload The payload to compare.
+     * @param length The length of the payload.
+     */
+    static bool equals(
+        const char* keyword,
+        const uint8_t* payload,
+        const uint16_t length
+    );
+};
+
+#endif
@@ -1,122 +1,416 @@
+#include <Arduino.h>
+
 #include "HANumeric.h"
 
 const uint8_t HANumeric::MaxDigitsNb = 19;
+const uint8_t HANumeric::MaxStrLength;
+
+/// Two-digit representations of numbers from 00 to 99.
+static const char DigitPairs[] PROGMEM = {
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899"
+};
+
+/// The largest power of ten that fits the 32-bit value. It's used for splitting 64-bit values.
+static const uint32_t Max32BitPowerOfTen = 1000000000UL;
+
+/**
+ * Returns the number of decimal digits of the given value.
+ * Only comparisons and multiplications are used, so it's cheap on 8-bit MCUs.
+ */
+static uint8_t countDigits(const uint32_t value)
+{
+    uint8_t digitsNb = 1;
+    uint32_t threshold = 10;
+
+    while (value >= threshold) {
+        digitsNb++;
+
+        if (digitsNb == 10) {
+            break; // the next threshold doesn't fit 32 bits
+        }
+
+        threshold *= 10;
+    }
+
+    return digitsNb;
+}
+
+/**
+ * Returns the number of decimal digits of the given value.
+ * The 64-bit division is only used if the value doesn't fit 32 bits.
+ */
+static uint8_t countDigits(const uint64_t value)
+{
+    if (value > UINT32_MAX) {
+        return countDigits(value / Max32BitPowerOfTen) + 9;
+    }
+
+    return countDigits(static_cast<uint32_t>(value));
+}
+
+/**
+ * Writes digits of the given value backwards, two digits at once.
+ *
+ * @param end Pointer to the position right after the last digit.
+ * @param value The value to format.
+ * @param minDigitsNb The number of digits that's padded with zeros.
+ * @returns Pointer to the first written digit.
+ */
+static char* formatDigits(char* end, uint32_t value, const uint8_t minDigitsNb = 1)
+{
+    char* ch = end;
+
+    while (value >= 100) {
+        const uint8_t pair = (value % 100) * 2;
+        value /= 100;
+
+        *--ch = pgm_read_byte(&DigitPairs[pair + 1]);
+        *--ch = pgm_read_byte(&DigitPairs[pair]);
+    }
+
+    if (value >= 10) {
+        const uint8_t pair = value * 2;
+        *--ch = pgm_read_byte(&DigitPairs[pair + 1]);
+        *--ch = pgm_read_byte(&DigitPairs[pair]);
+    } else {
+        *--ch = '0' + value;
+    }
+
+    while (end - ch < minDigitsNb) {
+        *--ch = '0';
+    }
+
+    return ch;
+}
+
+/**
+ * Writes digits of the given value backwards.
+ * The 64-bit value is split into 32-bit chunks of nine digits.
+ *
+ * @param end Pointer to the position right after the last digit.
+ * @param value The value to format.
+ * @returns Pointer to the first written digit.
+ */
+static char* formatDigits(char* end, uint64_t value)
+{
+    while (value > UINT32_MAX) {
+        const uint32_t chunk = static_cast<uint32_t>(value % Max32BitPowerOfTen);
+        value /= Max32BitPowerOfTen;
+        end = formatDigits(end, chunk, 9);
+    }
+
+    return formatDigits(end, static_cast<uint32_t>(value));
+}
+
+#if !defined(__AVR__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// 32-bit and 64-bit platforms parse multiple digits at once using SWAR (SIMD within a register)
+#define AHA_NUMERIC_SWAR
+#endif
+
+#ifdef AHA_NUMERIC_SWAR
+/**
+ * Returns `true` if all bytes of the given chunk are ASCII digits.
+ */
+static inline bool isEightDigits(const uint64_t chunk)
+{
+    return (
+        (chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+        (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)
+    ) == 0x3333333333333333ULL;
+}
+
+/**
+ * Converts eight ASCII digits (the first digit in the lowest byte) into the number.
+ * Digits are combined in pairs, then in fours and finally in eights using three multiplications.
+ */
+static inline uint32_t parseEightDigits(uint64_t chunk)
+{
+    chunk = ((chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return static_cast<uint32_t>(((chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+}
+
+/**
+ * Returns `true` if all bytes of the given chunk are ASCII digits.
+ */
+static inline bool isFourDigits(const uint32_t chunk)
+{
+    return (
+        (chunk & 0xF0F0F0F0U) |
+        (((chunk + 0x06060606U) & 0xF0F0F0F0U) >> 4)
+    ) == 0x33333333U;
+}
+
+/**
+ * Converts four ASCII digits (the first digit in the lowest byte) into the number.
+ */
+static inline uint32_t parseFourDigits(uint32_t chunk)
+{
+    chunk = ((chunk & 0x0F0F0F0FU) * 2561) >> 8;
+    return ((chunk & 0x00FF00FFU) * 6553601) >> 16;
+}
+#endif
+
+#ifdef AHA_NUMERIC_SWAR
+/**
+ * Appends chunks of eight and four ASCII digits to the value (from left to right).
+ * It's kept out of line, so parsing of short numbers doesn't pay for the SWAR setup.
+ *
+ * @param ch Pointer to the first character.
+ * @param end Pointer to the position right after the last character.
+ * @param value The value that's going to be extended with the digits.
+ * @returns Pointer to the first character that wasn't parsed.
+ */
+static const uint8_t* __attribute__((noinline)) parseDigitChunks(
+    const uint8_t* ch,
+    const uint8_t* end,
+    uint64_t& value
+)
+{
+    while (end - ch >= 8) {
+        uint64_t chunk;
+        memcpy(&chunk, ch, sizeof(chunk));
+        if (!isEightDigits(chunk)) {
+            break;
+        }
+
+        value = value * 100000000ULL + parseEightDigits(chunk);
+        ch += 8;
+    }
+
+    if (end - ch >= 4) {
+        uint32_t chunk;
+        memcpy(&chunk, ch, sizeof(chunk));
+        if (isFourDigits(chunk)) {
+            value = value * 10000 + parseFourDigits(chunk);
+            ch += 4;
+        }
+    }
+
+    return ch;
+}
+#endif
+
+/**
+ * Appends the ASCII digits to the value (from left to right) until the first non-digit character.
+ * The caller needs to verify the number of parsed digits, as the value may overflow.
+ *
+ * @param ch Pointer to the first character.
+ * @param end Pointer to the position right after the last character.
+ * @param value The value that's going to be extended with the digits.
+ * @returns Pointer to the first character that's not a digit (or `end`).
+ */
+static inline const uint8_t* parseDigits(
+    const uint8_t* ch,
+    const uint8_t* end,
+    uint64_t& value
+)
+{
+#ifdef AHA_NUMERIC_SWAR
+    if (end - ch >= 4) {
+        ch = parseDigitChunks(ch, end, value);
+    }
+#endif
+
+    if (value == 0) {
+        // up to nine leading digits fit 32 bits, which is much cheaper on 8-bit MCUs
+        const uint8_t* limit = end - ch > 9 ? ch + 9 : end;
+        uint32_t leadingValue = 0;
+
+        while (ch != limit) {
+            const uint8_t digit = *ch - '0';
+            if (digit > 9) {
+                value = leadingValue;
+                return ch;
+            }
+
+            leadingValue = leadingValue * 10 + digit;
+            ch++;
+        }
+
+        value = leadingValue;
+    }
+
+    while (ch != end) {
+        const uint8_t digit = *ch - '0';
+        if (digit > 9) {
+            break;
+        }
+
+        value = value * 10 + digit;
+        ch++;
+    }
+
+    return ch;
+}
 
 HANumeric HANumeric::fromStr(const uint8_t* buffer, const uint16_t length)
 {
-    if (length == 0) {
+    return parse(buffer, length, 0, false);
+}
+
+HANumeric HANumeric::fromStr(
+    const uint8_t* buffer,
+    const uint16_t length,
+    const uint8_t precision
+)
+{
+    return parse(buffer, length, precision, true);
+}
+
+HANumeric HANumeric::parse(
+    const uint8_t* buffer,
+    const uint16_t length,
+    const uint8_t precision,
+    const bool allowDecimalPoint
+)
+{
+    if (!buffer || length == 0) {
         return HANumeric();
     }
 
-    const uint8_t* firstCh = &buffer[0];
-    int64_t out = 0;
-    bool isSigned = false;
+    const uint8_t* ch = buffer;
+    const uint8_t* end = &buffer[length];
+    const bool isSigned = *ch == '-';
 
-    if (*firstCh == '-') {
-        isSigned = true;
-        firstCh++;
+    if (isSigned) {
+        ch++;
     }
 
-    uint8_t digitsNb = isSigned ? length - 1 : length;
-    if (digitsNb > MaxDigitsNb) {
+    uint64_t value = 0;
+    const uint8_t* integerBegin = ch;
+    ch = parseDigits(ch, end, value);
+
+    const uint16_t integerDigitsNb = ch - integerBegin;
+    if (integerDigitsNb == 0 || integerDigitsNb + precision > MaxDigitsNb) {
         return HANumeric();
     }
 
-    uint64_t base = 1;
-    const uint8_t* ptr = &buffer[length - 1];
+    uint8_t decimalDigitsNb = 0;
 
-    while (ptr >= firstCh) {
-        uint8_t digit = *ptr - '0';
-        if (digit > 9) {
+    if (ch != end) {
+        if (!allowDecimalPoint || *ch != '.' || ch + 1 == end) {
             return HANumeric();
         }
 
-        out += digit * base;
-        ptr--;
-        base *= 10;
+        ch++;
+
+        while (ch != end) {
+            const uint8_t digit = *ch - '0';
+            if (digit > 9) {
+                return HANumeric();
+            }
+
+            // digits that don't fit the precision are truncated
+            if (decimalDigitsNb < precision) {
+                value = value * 10 + digit;
+                decimalDigitsNb++;
+            }
+
+            ch++;
+        }
+    }
+
+    for (; decimalDigitsNb < precision; decimalDigitsNb++) {
+        value *= 10;
+    }
+
+    const uint64_t maxValue = isSigned
+        ? static_cast<uint64_t>(INT64_MAX) + 1
+        : static_cast<uint64_t>(INT64_MAX);
+    if (value > maxValue) {
+        return HANumeric();
     }
 
-    return HANumeric(isSigned ? out * -1 : out);
+    HANumeric number;
+    number.assign(static_cast<int64_t>(isSigned ? 0 - value : value), precision);
+    return number;
 }
 
-HANumeric::HANumeric():
-    _isSet(false),
-    _value(0),
-    _precision(0)
+HANumeric::HANumeric()
 {
-
+    reset();
 }
 
-HANumeric::HANumeric(const float value, const uint8_t precision):
-    _isSet(true),
-    _precision(precision)
+HANumeric::HANumeric(const float value, const uint8_t precision)
 {
-    _value = value * static_cast<float>(getPrecisionBase());
+    assign(value * static_cast<float>(calculatePrecisionBase(precision)), precision);
 }
 
-HANumeric::HANumeric(const int8_t value, const uint8_t precision):
-    _isSet(true),
-    _precision(precision)
+HANumeric::HANumeric(const int8_t value, const uint8_t precision)
 {
-    _value = value * static_cast<int32_t>(getPrecisionBase());
+    assign(value * static_cast<int32_t>(calculatePrecisionBase(precision)), precision);
 }
 
-HANumeric::HANumeric(const int16_t value, const uint8_t precision):
-    _isSet(true),
-    _precision(precision)
+HANumeric::HANumeric(const int16_t value, const uint8_t precision)
 {
-    _value = value * static_cast<int32_t>(getPrecisionBase());
+    assign(value * static_cast<int32_t>(calculatePrecisionBase(precision)), precision);
 }
 
-HANumeric::HANumeric(const int32_t value, const uint8_t precision):
-    _isSet(true),
-    _precision(precision)
+HANumeric::HANumeric(const int32_t value, const uint8_t precision)
 {
-    _value = value * static_cast<int32_t>(getPrecisionBase());
+    assign(value * static_cast<int32_t>(calculatePrecisionBase(precision)), precision);
 }
 
-HANumeric::HANumeric(const uint8_t value, const uint8_t precision):
-    _isSet(true),
-    _precision(precision)
+HANumeric::HANumeric(const uint8_t value, const uint8_t precision)
 {
-    _value = value * getPrecisionBase();
+    assign(value * calculatePrecisionBase(precision), precision);
 }
 
-HANumeric::HANumeric(const uint16_t value, const uint8_t precision):
-    _isSet(true),
-    _precision(precision)
+HANumeric::HANumeric(const uint16_t value, const uint8_t precision)
 {
-    _value = value * getPrecisionBase();
+    assign(value * calculatePrecisionBase(precision), precision);
 }
 
-HANumeric::HANumeric(const uint32_t value, const uint8_t precision):
-    _isSet(true),
-    _precision(precision)
+HANumeric::HANumeric(const uint32_t value, const uint8_t precision)
 {
-    _value = value * getPrecisionBase();
+    assign(value * calculatePrecisionBase(precision), precision);
 }
 
 #ifdef ARDUINOHA_INT_OVERLOAD
-HANumeric::HANumeric(const int value, const uint8_t precision):
-    _isSet(true),
-    _precision(precision)
+HANumeric::HANumeric(const int value, const uint8_t precision)
 {
-    _value = value * static_cast<int>(getPrecisionBase());
+    assign(value * static_cast<int>(calculatePrecisionBase(precision)), precision);
 }
 #endif
 
-HANumeric::HANumeric(const int64_t value):
-    _isSet(true),
-    _value(value),
-    _precision(0)
+uint32_t HANumeric::getPrecisionBase() const
+{
+    return calculatePrecisionBase(getPrecision());
+}
+
+#ifdef ARDUINOHA_COMPACT_NUMERIC
+void HANumeric::assign(const int64_t value, const uint8_t precision)
 {
+    if (precision > MaxPrecision || value < -MaxBaseValue || value > MaxBaseValue) {
+        reset();
+        return;
+    }
 
+    _data = static_cast<int32_t>(value) * (MaxPrecision + 1) + precision;
+}
+#else
+void HANumeric::assign(const int64_t value, const uint8_t precision)
+{
+    _value = value;
+    _isSet = true;
+    _precision = precision;
 }
+#endif
 
-uint32_t HANumeric::getPrecisionBase() const
+uint32_t HANumeric::calculatePrecisionBase(const uint8_t precision)
 {
     // using pow() increases the flash size by ~2KB
-    switch (_precision) {
+    switch (precision) {
     case 1:
         return 10;
 
@@ -133,82 +427,73 @@ uint32_t HANumeric::getPrecisionBase() const
 
 uint8_t HANumeric::calculateSize() const
 {
-    if (!_isSet) {
+    if (!isSet()) {
         return 0;
     }
 
-    int64_t value = _value;
-    const bool isSigned = value < 0;
-
-    if (isSigned) {
-        value *= -1;
-    }
-
-    uint8_t digitsNb = 1;
-    while (value > 9) {
-        value /= 10;
-        digitsNb++;
-    }
-
-    if (isSigned) {
-        digitsNb++; // sign
+    const int64_t value = getBaseValue();
+    if (value == 0) {
+        return 1;
     }
 
-    if (_precision > 0) {
-        if (value == 0) {
-            return 1;
-        }
-
-        // one digit + dot + decimal digits (+ sign)
-        const uint8_t minValue = isSigned ? _precision + 3 : _precision + 2;
-        return digitsNb >= minValue ? digitsNb + 1 : minValue;
+    const uint8_t precision = getPrecision();
+    const bool isSigned = value < 0;
+    const uint8_t digitsNb = countDigits(
+        isSigned ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value)
+    );
+    uint8_t size = digitsNb;
+
+    if (precision > 0) {
+        // integer digits (at least one) + dot + decimal digits
+        size = (digitsNb > precision ? digitsNb : precision + 1) + 1;
     }
 
-    return digitsNb;
+    return isSigned ? size + 1 : size;
 }
 
 uint16_t HANumeric::toStr(char* dst) const
 {
-    char* prefixCh = &dst[0];
-    if (!_isSet || _value == 0) {
-        *prefixCh = '0';
+    const int64_t value = getBaseValue();
+    if (!isSet() || value == 0) {
+        *dst = '0';
         return 1;
     }
 
-    int64_t value = _value;
-    const uint8_t numberLength = calculateSize();
+    const uint8_t precision = getPrecision();
+    const uint64_t absValue = value < 0
+        ? 0 - static_cast<uint64_t>(value)
+        : static_cast<uint64_t>(value);
+    char* ch = dst;
+
     if (value < 0) {
-        value *= -1;
-        *prefixCh = '-';
-        prefixCh++;
+        *ch++ = '-';
     }
 
-    if (_precision > 0) {
-        uint8_t i = _precision;
-        char* dotPtr = prefixCh + 1;
-        do {
-            *prefixCh = '0';
-            prefixCh++;
-        } while(i-- > 0);
-
-        *dotPtr = '.';
+    // digits are written in place, so the length needs to be known upfront
+    if (precision == 0) {
+        const uint8_t digitsNb = countDigits(absValue);
+        formatDigits(ch + digitsNb, absValue);
+        return ch - dst + digitsNb;
     }
 
-    char* ch = &dst[numberLength - 1];
-    char* lastCh = ch;
-    char* dotPos = _precision > 0 ? &dst[numberLength - 1 - _precision] : nullptr;
+    const uint32_t precisionBase = getPrecisionBase();
+    uint64_t integerPart;
+    uint32_t decimalPart;
 
-    while (value != 0) {
-        if (ch == dotPos) {
-            *dotPos = '.';
-            ch--;
-            continue;
-        }
-
-        *ch = (value % 10) + '0';
-        value /= 10;
-        ch--;
+    if (absValue <= UINT32_MAX) {
+        integerPart = static_cast<uint32_t>(absValue) / precisionBase;
+        decimalPart = static_cast<uint32_t>(absValue) % precisionBase;
+    } else {
+        integerPart = absValue / precisionBase;
+        decimalPart = absValue % precisionBase;
     }
 
-    return lastCh - &dst[0] + 1;
+    const uint8_t integerDigitsNb = countDigits(integerPart);
+    formatDigits(ch + integerDigitsNb, integerPart);
+    ch += integerDigitsNb;
+
+    *ch++ = '.';
+    formatDigits(ch + precision, decimalPart, precision);
+
+    return ch - dst + precision;
 }
@@ -14,6 +14,17 @@ public:
     /// The maximum number of digits that the base value can have (int64_t).
     static const uint8_t MaxDigitsNb;
 
+    /// The maximum length of the string representation of the number (digits, sign and decimal point).
+    static const uint8_t MaxStrLength = 21;
+
+#ifdef ARDUINOHA_COMPACT_NUMERIC
+    /// The maximum precision of the number in the compact mode (two bits).
+    static const uint8_t MaxPrecision = 3;
+
+    /// The maximum absolute base value in the compact mode (30-bit signed value).
+    static const int32_t MaxBaseValue = 0x1FFFFFFF;
+#endif
+
     /**
      * Deserializes number from the given buffer.
      * Please note that the class expected buffer to contain the base number.
@@ -25,6 +36,22 @@ public:
      */
     static HANumeric fromStr(const uint8_t* buffer, const uint16_t length);
 
+    /**
+     * Deserializes decimal number from the given buffer and converts it to the given precision.
+     * For example, deserializing `21.5` with precision set to `2` results in base value `2150`.
+     * Integers are accepted as well (`21` becomes `2100`).
+     * Decimal digits that don't fit the precision are truncated.
+     *
+     * @param buffer The buffer that contains the number.
+     * @param length The length of the buffer.
+     * @param precision The number of digits in the decimal part of the output number.
+     */
+    static HANumeric fromStr(
+        const uint8_t* buffer,
+        const uint16_t length,
+        const uint8_t precision
+    );
+
     /**
      * Creates an empty number representation.
      */
@@ -104,13 +131,16 @@ public:
     HANumeric(const int value, const uint8_t precision);
 #endif
 
+    /**
+     * Creates a copy of the given number.
+     */
+    HANumeric(const HANumeric& a) = default;
+
     void operator= (const HANumeric& a) {
         if (!a.isSet()) {
             reset();
         } else {
-            _isSet = a.isSet();
-            _value = a.getBaseValue();
-            _precision = a.getPrecision();
+            assign(a.getBaseValue(), a.getPrecision());
         }
     }
 
@@ -135,14 +165,57 @@ public:
 
     /**
      * Converts the number to the string.
+     * The number is formatted in a single pass, so there is no need to call
+     * HANumeric::calculateSize() before. The returned length can be used instead.
      *
      * @param dst Destination where the number will be saved.
      *            The null terminator is not added at the end.
      * @return The number of written characters.
-     * @note The `dst` size should be calculated using HANumeric::calculateSize() method plus 1 extra byte for the null terminator.
+     * @note The `dst` size should be at least HANumeric::MaxStrLength (or HANumeric::calculateSize()) plus 1 extra byte for the null terminator.
      */
     uint16_t toStr(char* dst) const;
 
+#ifdef ARDUINOHA_COMPACT_NUMERIC
+    /**
+     * Returns true if the base value is set.
+     */
+    inline bool isSet() const
+        { return _data > UnsetData + MaxPrecision; }
+
+    /**
+     * Sets the base value without converting it to the proper precision.
+     * The number is reset if the value doesn't fit the compact storage.
+     */
+    inline void setBaseValue(int64_t value)
+        { assign(value, getPrecision()); }
+
+    /**
+     * Returns the base value of the number.
+     */
+    inline int64_t getBaseValue() const
+        { return isSet() ? (_data - getPrecision()) / (MaxPrecision + 1) : 0; }
+
+    /**
+     * Sets the precision of the number (number of digits in the decimal part).
+     * The number is reset if the precision is greater than HANumeric::MaxPrecision.
+     *
+     * @param precision The precision to use.
+     */
+    inline void setPrecision(const uint8_t precision)
+        { precision > MaxPrecision ? reset() : (void)(_data = _data - getPrecision() + precision); }
+
+    /**
+     * Returns the precision of the number.
+     */
+    inline uint8_t getPrecision() const
+        { return static_cast<uint32_t>(_data) & MaxPrecision; }
+
+    /**
+     * Resets the number to the defaults.
+     */
+    inline void reset()
+        { _data = UnsetData; }
+#else
     /**
      * Returns true if the base value is set.
      */
@@ -180,55 +253,104 @@ public:
      */
     inline void reset()
         { _isSet = false; _value = 0; _precision = 0; }
+#endif
 
     inline bool isUInt8() const
-        { return _isSet && _precision == 0 && _value >= 0 && _value <= UINT8_MAX; }
+        { return isInteger(0, UINT8_MAX); }
 
     inline bool isUInt16() const
-        { return _isSet && _precision == 0 && _value >= 0 && _value <= UINT16_MAX; }
+        { return isInteger(0, UINT16_MAX); }
 
     inline bool isUInt32() const
-        { return _isSet && _precision == 0 && _value >= 0 && _value <= UINT32_MAX; }
+        { return isInteger(0, UINT32_MAX); }
 
     inline bool isInt8() const
-        { return _isSet && _precision == 0 && _value >= INT8_MIN && _value <= INT8_MAX; }
+        { return isInteger(INT8_MIN, INT8_MAX); }
 
     inline bool isInt16() const
-        { return _isSet && _precision == 0 && _value >= INT16_MIN && _value <= INT16_MAX; }
+        { return isInteger(INT16_MIN, INT16_MAX); }
 
     inline bool isInt32() const
-        { return _isSet && _precision == 0 && _value >= INT32_MIN && _value <= INT32_MAX; }
+        { return isInteger(INT32_MIN, INT32_MAX); }
 
     inline bool isFloat() const
-        { return _isSet && _precision > 0; }
+        { return isSet() && getPrecision() > 0; }
 
     inline uint8_t toUInt8() const
-        { return static_cast<uint8_t>(_value); }
+        { return static_cast<uint8_t>(getBaseValue()); }
 
     inline uint16_t toUInt16() const
-        { return static_cast<uint16_t>(_value); }
+        { return static_cast<uint16_t>(getBaseValue()); }
 
     inline uint32_t toUInt32() const
-        { return static_cast<uint32_t>(_value); }
+        { return static_cast<uint32_t>(getBaseValue()); }
 
     inline int8_t toInt8() const
-        { return static_cast<int8_t>(_value); }
+        { return static_cast<int8_t>(getBaseValue()); }
 
     inline int16_t toInt16() const
-        { return static_cast<int16_t>(_value); }
+        { return static_cast<int16_t>(getBaseValue()); }
 
     inline int32_t toInt32() const
-        { return static_cast<int32_t>(_value); }
+        { return static_cast<int32_t>(getBaseValue()); }
 
     inline float toFloat() const
-        { return _value / (float)getPrecisionBase(); }
+        { return getBaseValue() / (float)getPrecisionBase(); }
 
 private:
-    bool _isSet;
+#ifdef ARDUINOHA_COMPACT_NUMERIC
+    /// The value of `_data` that represents the number that's not set (the lowest base value).
+    static const int32_t UnsetData = INT32_MIN;
+
+    /// The base value multiplied by four plus the precision (two lowest bits).
+    int32_t _data;
+#else
+    /// The base value of the number.
     int64_t _value;
+
+    /// Specifies whether the base value is set.
+    bool _isSet;
+
+    /// The number of digits in the decimal part.
     uint8_t _precision;
+#endif
+
+    /**
+     * Sets the base value and the precision of the number.
+     * In the compact mode the number is reset if the value or the precision doesn't fit the storage.
+     *
+     * @param value The base value.
+     * @param precision The number of digits in the decimal part.
+     */
+    void assign(const int64_t value, const uint8_t precision);
+
+    /**
+     * Returns multiplier for the given precision.
+     *
+     * @param precision The number of digits in the decimal part.
+     */
+    static uint32_t calculatePrecisionBase(const uint8_t precision);
 
-    explicit HANumeric(const int64_t value);
+    /**
+     * Returns `true` if the number is an integer (zero precision) within the given range.
+     */
+    inline bool isInteger(const int64_t min, const int64_t max) const
+        { return isSet() && getPrecision() == 0 && getBaseValue() >= min && getBaseValue() <= max; }
+
+    /**
+     * Parses the given buffer with the optional decimal part.
+     *
+     * @param buffer The buffer that contains the number.
+     * @param length The length of the buffer.
+     * @param precision The number of digits in the decimal part of the output number.
+     * @param allowDecimalPoint Specifies whether the decimal part is allowed in the buffer.
+     */
+    static HANumeric parse(
+        const uint8_t* buffer,
+        const uint16_t length,
+        const uint8_t precision,
+        const bool allowDecimalPoint
+    );
 };
 
 #endif
@@ -13,6 +13,10 @@
 #include "../utils/HANumeric.h"
 #include "../device-types/HABaseDeviceType.h"
 
+#ifndef pgm_read_ptr
+#define pgm_read_ptr(addr) (*(const void* const*)(addr))
+#endif
+
 uint16_t HASerializer::calculateConfigTopicLength(
     const __FlashStringHelper* componentName,
     const char* objectId
@@ -136,38 +140,250 @@ bool HASerializer::compareDataTopics(
     const __FlashStringHelper* topic
 )
 {
-    if (!actualTopic) {
+    if (!topic) {
+        return false;
+    }
+
+    const char* ch = matchDataTopicPrefix(actualTopic, objectId);
+    ch = matchTopicSegment(ch, AHAFROMFSTR(topic), true);
+    return ch && *ch == 0;
+}
+
+const char* HASerializer::matchDataTopicPrefix(
+    const char* actualTopic,
+    const char* objectId
+)
+{
+    const HAMqtt* mqtt = HAMqtt::instance();
+    if (
+        !actualTopic ||
+        !mqtt ||
+        !mqtt->getDataPrefix() ||
+        !mqtt->getDevice() ||
+        !mqtt->getDevice()->getUniqueId()
+    ) {
+        return nullptr;
+    }
+
+    // the topic is compared segment by segment without generating the expected topic
+    const char* ch = matchTopicSegment(actualTopic, mqtt->getDataPrefix());
+    ch = matchTopicSegment(ch, HASerializerSlash, true);
+    ch = matchTopicSegment(ch, mqtt->getDevice()->getUniqueId());
+    ch = matchTopicSegment(ch, HASerializerSlash, true);
+
+    if (objectId) {
+        ch = matchTopicSegment(ch, objectId);
+        ch = matchTopicSegment(ch, HASerializerSlash, true);
+    }
+
+    return ch;
+}
+
+bool HASerializer::splitDataTopic(
+    const char* actualTopic,
+    const char** objectId,
+    uint16_t* objectIdLength,
+    const char** topic
+)
+{
+    const HAMqtt* mqtt = HAMqtt::instance();
+    if (
+        !actualTopic ||
+        !mqtt ||
+        !mqtt->getDataPrefix() ||
+        !mqtt->getDevice() ||
+        !mqtt->getDevice()->getUniqueId()
+    ) {
         return false;
     }
 
-    const uint16_t topicLength = calculateDataTopicLength(objectId, topic);
-    if (topicLength == 0) {
+    const char* ch = matchTopicSegment(actualTopic, mqtt->getDataPrefix());
+    ch = matchTopicSegment(ch, HASerializerSlash, true);
+    ch = matchTopicSegment(ch, mqtt->getDevice()->getUniqueId());
+    ch = matchTopicSegment(ch, HASerializerSlash, true);
+    if (!ch) {
         return false;
     }
 
-    char expectedTopic[topicLength];
-    if (!generateDataTopic(expectedTopic, objectId, topic)) {
+    const char* separator = strchr(ch, '/');
+    if (!separator || separator == ch || separator[1] == 0) {
         return false;
     }
 
-    return memcmp(actualTopic, expectedTopic, topicLength) == 0;
+    *objectId = ch;
+    *objectIdLength = separator - ch;
+    *topic = separator + 1;
+    return true;
+}
+
+const char* HASerializer::matchTopicSegment(
+    const char* actualTopic,
+    const char* segment,
+    const bool progmemSegment
+)
+{
+    if (!actualTopic) {
+        return nullptr;
+    }
+
+    while (true) {
+        const char expectedCh = progmemSegment
+            ? static_cast<char>(pgm_read_byte(segment))
+            : *segment;
+        if (expectedCh == 0) {
+            return actualTopic;
+        }
+
+        if (*actualTopic != expectedCh) {
+            return nullptr;
+        }
+
+        actualTopic++;
+        segment++;
+    }
+}
+
+/// The storage shared by serializers of device types. Device types build one serializer at a time.
+alignas(HASerializer) static uint8_t sharedSerializer[sizeof(HASerializer)];
+
+/// Specifies whether the shared storage is used by an instance.
+static bool sharedSerializerUsed = false;
+
+#ifdef ARDUINOHA_STATIC_MEMORY
+static_assert(
+    ARDUINOHA_STATIC_SERIALIZER_SIZE > 0 && ARDUINOHA_STATIC_SERIALIZER_SIZE <= UINT8_MAX,
+    "ARDUINOHA_STATIC_SERIALIZER_SIZE needs to be in range 1-255"
+);
+
+/// Entries of the shared serializer.
+static HASerializer::SerializerEntry sharedEntries[ARDUINOHA_STATIC_SERIALIZER_SIZE];
+
+/// The number of entries that fit the shared storage.
+static const uint8_t sharedEntriesCapacity = ARDUINOHA_STATIC_SERIALIZER_SIZE;
+#else
+/// Entries of the shared serializer. The array grows to the size of the largest serializer.
+static HASerializer::SerializerEntry* sharedEntries = nullptr;
+
+/// The number of entries that fit the shared storage.
+static uint8_t sharedEntriesCapacity = 0;
+#endif
+
+HASerializer::HASerializer(
+    HABaseDeviceType* deviceType,
+    const uint8_t maxEntriesNb
+) :
+    _deviceType(deviceType),
+    _entriesNb(0),
+    _maxEntriesNb(maxEntriesNb),
+    _entries(nullptr),
+    _ownsEntries(false),
+    _schema(nullptr),
+    _features(0),
+    _dataTopicsNb(0)
+{
+    if (this != reinterpret_cast<HASerializer*>(sharedSerializer)) {
+        _entries = new SerializerEntry[maxEntriesNb];
+        _ownsEntries = true;
+        return;
+    }
+
+#ifdef ARDUINOHA_STATIC_MEMORY
+    _maxEntriesNb = sharedEntriesCapacity;
+#else
+    if (sharedEntriesCapacity < maxEntriesNb) {
+        delete[] sharedEntries;
+        sharedEntries = new SerializerEntry[maxEntriesNb];
+        sharedEntriesCapacity = maxEntriesNb;
+    }
+#endif
+
+    _entries = sharedEntries;
 }
 
 HASerializer::HASerializer(
     HABaseDeviceType* deviceType,
+    SerializerEntry* entries,
     const uint8_t maxEntriesNb
 ) :
     _deviceType(deviceType),
     _entriesNb(0),
     _maxEntriesNb(maxEntriesNb),
-    _entries(new SerializerEntry[maxEntriesNb])
+    _entries(entries),
+    _ownsEntries(false),
+    _schema(nullptr),
+    _features(0),
+    _dataTopicsNb(0)
+{
+
+}
+
+HASerializer::HASerializer(
+    HABaseDeviceType* deviceType,
+    const SchemaEntry* schema,
+    const uint8_t schemaSize,
+    const uint16_t features
+) :
+    _deviceType(deviceType),
+    _entriesNb(schemaSize),
+    _maxEntriesNb(schemaSize),
+    _entries(nullptr),
+    _ownsEntries(false),
+    _schema(schema),
+    _features(features),
+    _dataTopicsNb(0)
 {
+    for (uint8_t i = 0; i < _entriesNb; i++) {
+        SerializerEntry storage;
+        const SerializerEntry* entry = getEntry(i, storage);
 
+        if (entry && entry->type == TopicEntryType && !entry->value) {
+            _dataTopicsNb++;
+        }
+    }
 }
 
 HASerializer::~HASerializer()
 {
-    delete[] _entries;
+    if (_ownsEntries) {
+        delete[] _entries;
+    }
+}
+
+void* HASerializer::operator new(size_t size) noexcept
+{
+    if (!sharedSerializerUsed && size <= sizeof(sharedSerializer)) {
+        sharedSerializerUsed = true;
+        return sharedSerializer;
+    }
+
+#ifdef ARDUINOHA_STATIC_MEMORY
+    return nullptr;
+#else
+    return ::operator new(size);
+#endif
+}
+
+void HASerializer::operator delete(void* ptr) noexcept
+{
+    if (ptr == sharedSerializer) {
+        sharedSerializerUsed = false;
+        return;
+    }
+
+#ifndef ARDUINOHA_STATIC_MEMORY
+    ::operator delete(ptr);
+#endif
+}
+
+void HASerializer::releaseSharedStorage()
+{
+#ifndef ARDUINOHA_STATIC_MEMORY
+    if (!sharedSerializerUsed) {
+        delete[] sharedEntries;
+        sharedEntries = nullptr;
+        sharedEntriesCapacity = 0;
+    }
+#endif
 }
 
 void HASerializer::set(
@@ -180,79 +396,275 @@ void HASerializer::set(
         return;
     }
 
-    SerializerEntry* entry = addEntry();
+    SerializerEntry* entry = addEntry(property);
+    if (!entry) {
+        return;
+    }
+
     entry->type = PropertyEntryType;
     entry->subtype = static_cast<uint8_t>(valueType);
-    entry->property = property;
     entry->value = value;
 }
 
+void HASerializer::update(
+    const __FlashStringHelper* property,
+    const void* value,
+    PropertyValueType valueType
+)
+{
+    for (uint8_t i = 0; i < _entriesNb; i++) {
+        SerializerEntry& entry = _entries[i];
+        if (entry.type == PropertyEntryType && property && getEntryProperty(&entry) == property) {
+            if (!value) {
+                return;
+            }
+
+            entry.subtype = static_cast<uint8_t>(valueType);
+            entry.value = value;
+            return;
+        }
+    }
+
+    set(property, value, valueType);
+}
+
 void HASerializer::set(const FlagType flag)
 {
-    if (flag == WithDevice || flag == WithUniqueId) {
-        SerializerEntry* entry = addEntry();
-        entry->type = FlagEntryType;
-        entry->subtype = static_cast<uint8_t>(flag);
-        entry->property = nullptr;
-        entry->value = nullptr;
+    SerializerEntry resolvedEntry;
+    resolvedEntry.type = FlagEntryType;
+    resolvedEntry.subtype = static_cast<uint8_t>(flag);
+
+    if (!resolveFlag(resolvedEntry)) {
+        return;
+    }
+
+    SerializerEntry* entry = addEntry();
+    if (!entry) {
+        return;
+    }
+
+    *entry = resolvedEntry;
+
+    if (entry->type == TopicEntryType && !entry->value) {
+        _dataTopicsNb++;
+    }
+}
+
+void HASerializer::topic(const __FlashStringHelper* topic)
+{
+    if (!_deviceType || !topic) {
+        return;
+    }
+
+    SerializerEntry* entry = addEntry(topic);
+    if (!entry) {
+        return;
+    }
+
+    entry->type = TopicEntryType;
+    entry->value = nullptr;
+    _dataTopicsNb++;
+}
+
+const __FlashStringHelper* HASerializer::SerializerEntry::getProperty() const
+{
+    if (key == 0 || key >= HASerializerKeysNb) {
+        return nullptr;
+    }
+
+    return AHATOFSTR(pgm_read_ptr(&HASerializerKeys[key]));
+}
+
+const __FlashStringHelper* HASerializer::getEntryProperty(const SerializerEntry* entry) const
+{
+    if (entry->key != CustomKey) {
+        return entry->getProperty();
+    }
+
+    // the name of the custom entry is stored in the preceding entry
+    for (uint8_t i = 1; i < _entriesNb; i++) {
+        if (&_entries[i] == entry && _entries[i - 1].type == NameEntryType) {
+            return static_cast<const __FlashStringHelper*>(_entries[i - 1].value);
+        }
+    }
+
+    return nullptr;
+}
+
+static_assert(
+    HASerializerKeysNb < HASerializer::CustomKey,
+    "HASerializerKeys table doesn't fit the entry's key"
+);
+
+uint8_t HASerializer::findKey(const __FlashStringHelper* property)
+{
+    if (!property) {
+        return 0;
+    }
+
+    for (uint8_t i = 1; i < HASerializerKeysNb; i++) {
+        if (AHATOFSTR(pgm_read_ptr(&HASerializerKeys[i])) == property) {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+const HASerializer::SerializerEntry* HASerializer::getEntry(
+    const uint8_t index,
+    SerializerEntry& storage
+) const
+{
+    if (!_schema) {
+        // names of the custom entries are not serialized on their own
+        return _entries[index].type != NameEntryType ? &_entries[index] : nullptr;
+    }
+
+    SchemaEntry row;
+    memcpy_P(&row, &_schema[index], sizeof(SchemaEntry));
+
+    if ((row.features & _features) != row.features) {
+        return nullptr;
+    }
+
+    storage.type = row.type;
+    storage.subtype = row.subtype;
+    storage.key = row.key;
+    storage.value = nullptr;
+
+    switch (row.type) {
+    case PropertyEntryType:
+        storage.value = _deviceType->getSerializerValue(row.field);
+        return storage.value ? &storage : nullptr;
+
+    case FlagEntryType:
+        return resolveFlag(storage) ? &storage : nullptr;
+
+    default:
+        return &storage;
+    }
+}
+
+bool HASerializer::resolveFlag(SerializerEntry& entry) const
+{
+    const FlagType flag = static_cast<FlagType>(entry.subtype);
+
+    if (flag == WithDevice && _deviceType && HAMqtt::instance()->isDeviceDiscoveryEnabled()) {
+        // the device and the platform are serialized by the HAMqtt in the device-level config
+        return false;
+    } else if (flag == WithDevice || flag == WithUniqueId) {
+        entry.key = HANoKey;
+        entry.value = nullptr;
+        return true;
     } else if (flag == WithAvailability) {
         HAMqtt* mqtt = HAMqtt::instance();
         const bool isSharedAvailability = mqtt->getDevice()->isSharedAvailabilityEnabled();
         const bool isAvailabilityConfigured = _deviceType->isAvailabilityConfigured();
 
         if (!isSharedAvailability && !isAvailabilityConfigured) {
-            return; // not configured
+            return false; // not configured
         }
 
-        SerializerEntry* entry = addEntry();
-        entry->type = TopicEntryType;
-        entry->property = AHATOFSTR(HAAvailabilityTopic);
-        entry->value = isSharedAvailability
+        entry.type = TopicEntryType;
+        entry.subtype = 0;
+        entry.key = HAAvailabilityTopicKey;
+        entry.value = isSharedAvailability
             ? mqtt->getDevice()->getAvailabilityTopic()
             : nullptr;
+        return true;
     }
+
+    return false;
 }
 
-void HASerializer::topic(const __FlashStringHelper* topic)
+HASerializer::SerializerEntry* HASerializer::addEntry()
 {
-    if (!_deviceType || !topic) {
-        return;
+    if (_entriesNb >= _maxEntriesNb) {
+        ARDUINOHA_DEBUG_PRINTLN(F("AHA: serializer's entries limit reached"))
+        return nullptr;
     }
 
-    SerializerEntry* entry = addEntry();
-    entry->type = TopicEntryType;
-    entry->property = topic;
+    return &_entries[_entriesNb++];
 }
 
-HASerializer::SerializerEntry* HASerializer::addEntry()
+HASerializer::SerializerEntry* HASerializer::addEntry(const __FlashStringHelper* name)
 {
-    return &_entries[_entriesNb++]; // intentional lack of protection against overflow
+    const uint8_t key = findKey(name);
+    if (key != 0) {
+        SerializerEntry* entry = addEntry();
+        if (entry) {
+            entry->key = key;
+        }
+
+        return entry;
+    }
+
+    if (_entriesNb + 2 > _maxEntriesNb) {
+        ARDUINOHA_DEBUG_PRINTLN(F("AHA: serializer's entries limit reached"))
+        return nullptr;
+    }
+
+    SerializerEntry* nameEntry = addEntry();
+    nameEntry->type = NameEntryType;
+    nameEntry->subtype = 0;
+    nameEntry->key = HANoKey;
+    nameEntry->value = name;
+
+    SerializerEntry* entry = addEntry();
+    entry->key = CustomKey;
+    return entry;
 }
 
-uint16_t HASerializer::calculateSize() const
+uint16_t HASerializer::calculateSize(const bool withPlatform) const
 {
     uint16_t size =
         strlen_P(HASerializerJsonDataPrefix) +
         strlen_P(HASerializerJsonDataSuffix);
+    bool withSeparator = false;
+
+    if (withPlatform && _deviceType) {
+        size += calculatePlatformSize();
+        withSeparator = true;
+    }
+
+#ifdef ARDUINOHA_BASE_TOPIC
+    if (hasBaseTopic()) {
+        if (withSeparator) {
+            size += strlen_P(HASerializerJsonPropertiesSeparator);
+        }
+
+        size += calculateBaseTopicSize();
+        withSeparator = true;
+    }
+#endif
+
+    uint8_t outputEntriesNb = 0;
 
     for (uint8_t i = 0; i < _entriesNb; i++) {
-        const uint16_t entrySize = calculateEntrySize(&_entries[i]);
-        if (entrySize == 0) {
+        SerializerEntry storage;
+        const SerializerEntry* entry = getEntry(i, storage);
+        if (!entry) {
             continue;
         }
 
-        size += entrySize;
+        const uint16_t entrySize = calculateEntrySize(entry);
+        if (entrySize > 0) {
+            size += entrySize;
 
-        // items separator
-        if (i > 0) {
-            size += strlen_P(HASerializerJsonPropertiesSeparator);
+            // items separator
+            if (outputEntriesNb > 0 || withSeparator) {
+                size += strlen_P(HASerializerJsonPropertiesSeparator);
+            }
         }
+
+        outputEntriesNb++;
     }
 
     return size;
 }
 
-bool HASerializer::flush() const
+bool HASerializer::flush(const bool withPlatform) const
 {
     HAMqtt* mqtt = HAMqtt::instance();
     if (!mqtt || (_deviceType && !mqtt->getDevice())) {
@@ -260,21 +672,114 @@ bool HASerializer::flush() const
     }
 
     mqtt->writePayload(AHATOFSTR(HASerializerJsonDataPrefix));
+    bool withSeparator = false;
+
+    if (withPlatform && _deviceType) {
+        flushPlatform();
+        withSeparator = true;
+    }
+
+#ifdef ARDUINOHA_BASE_TOPIC
+    if (hasBaseTopic()) {
+        if (withSeparator) {
+            mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertiesSeparator));
+        }
+
+        if (!flushBaseTopic()) {
+            return false;
+        }
+
+        withSeparator = true;
+    }
+#endif
+
+    uint8_t outputEntriesNb = 0;
 
     for (uint8_t i = 0; i < _entriesNb; i++) {
-        if (i > 0) {
+        SerializerEntry storage;
+        const SerializerEntry* entry = getEntry(i, storage);
+        if (!entry) {
+            continue;
+        }
+
+        if (outputEntriesNb > 0 || withSeparator) {
             mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertiesSeparator));
         }
 
-        if (!flushEntry(&_entries[i])) {
+        if (!flushEntry(entry)) {
             return false;
         }
+
+        outputEntriesNb++;
     }
 
     mqtt->writePayload(AHATOFSTR(HASerializerJsonDataSuffix));
     return true;
 }
 
+uint16_t HASerializer::calculatePlatformSize() const
+{
+    return
+        // property name
+        strlen_P(HASerializerJsonPropertyPrefix) +
+        strlen_P(HAPlatformProperty) +
+        strlen_P(HASerializerJsonPropertySuffix) +
+        // property value
+        2 * strlen_P(HASerializerJsonEscapeChar) +
+        strlen_P(AHAFROMFSTR(_deviceType->componentName()));
+}
+
+void HASerializer::flushPlatform() const
+{
+    HAMqtt* mqtt = HAMqtt::instance();
+
+    // property name
+    mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
+    mqtt->writePayload(AHATOFSTR(HAPlatformProperty));
+    mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
+
+    // value
+    mqtt->writePayload(AHATOFSTR(HASerializerJsonEscapeChar));
+    mqtt->writePayload(_deviceType->componentName());
+    mqtt->writePayload(AHATOFSTR(HASerializerJsonEscapeChar));
+}
+
+uint16_t HASerializer::stage() const
+{
+    HAMqtt* mqtt = HAMqtt::instance();
+    if (!mqtt || !mqtt->getStagingBuffer()) {
+        return 0;
+    }
+
+    mqtt->beginPayloadCapture(
+        mqtt->getStagingBuffer(),
+        mqtt->getStagingBufferSize()
+    );
+    const bool result = flush();
+    const uint16_t length = mqtt->endPayloadCapture();
+
+    if (!result) {
+        return 0;
+    }
+
+    mqtt->countStagedPayload(length);
+    return length;
+}
+
+uint32_t HASerializer::calculateHash(const char* topic) const
+{
+    HAMqtt* mqtt = HAMqtt::instance();
+    if (!mqtt) {
+        return 0;
+    }
+
+    mqtt->beginPayloadHash(topic);
+    const bool result = flush();
+    const uint32_t hash = mqtt->endPayloadHash();
+
+    return result ? hash : 0;
+}
+
 uint16_t HASerializer::calculateEntrySize(const SerializerEntry* entry) const
 {
     switch (entry->type) {
@@ -282,7 +787,7 @@ uint16_t HASerializer::calculateEntrySize(const SerializerEntry* entry) const
         return
             // property name
             strlen_P(HASerializerJsonPropertyPrefix) +
-            strlen_P(AHAFROMFSTR(entry->property)) +
+            strlen_P(AHAFROMFSTR(getEntryProperty(entry))) +
             strlen_P(HASerializerJsonPropertySuffix) +
             // property value
             calculatePropertyValueSize(entry);
@@ -309,7 +814,7 @@ uint16_t HASerializer::calculateTopicEntrySize(
     // property name
     size +=
         strlen_P(HASerializerJsonPropertyPrefix) +
-        strlen_P(AHAFROMFSTR(entry->property)) +
+        strlen_P(AHAFROMFSTR(getEntryProperty(entry))) +
         strlen_P(HASerializerJsonPropertySuffix);
 
     // topic escape
@@ -323,9 +828,17 @@ uint16_t HASerializer::calculateTopicEntrySize(
             return 0;
         }
 
-        size += calculateDataTopicLength(
-            _deviceType->uniqueId(),
-            entry->property
+#ifdef ARDUINOHA_BASE_TOPIC
+        if (hasBaseTopic()) {
+            return
+                size +
+                strlen_P(HASerializerBaseTopicPrefix) +
+                strlen_P(AHAFROMFSTR(getEntryProperty(entry)));
+        }
+#endif
+
+        size += _deviceType->calculateDataTopicLength(
+            getEntryProperty(entry)
         ) - 1; // exclude null terminator
     }
 
@@ -338,7 +851,7 @@ uint16_t HASerializer::calculateFlagSize(const FlagType flag) const
     const HADevice* device = mqtt->getDevice();
 
     if (flag == WithDevice && device->getSerializer()) {
-        const uint16_t deviceLength = device->getSerializer()->calculateSize();
+        const uint16_t deviceLength = device->calculateSerializedSize();
         if (deviceLength == 0) {
             return 0;
         }
@@ -412,7 +925,7 @@ bool HASerializer::flushEntry(const SerializerEntry* entry) const
     switch (entry->type) {
     case PropertyEntryType: {
         mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
-        mqtt->writePayload(entry->property);
+        mqtt->writePayload(getEntryProperty(entry));
         mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
 
         return flushEntryValue(entry);
@@ -460,7 +973,7 @@ bool HASerializer::flushEntryValue(const SerializerEntry* entry) const
             entry->value
         );
 
-        char tmp[HANumeric::MaxDigitsNb + 1];
+        char tmp[HANumeric::MaxStrLength];
         const uint16_t length = value->toStr(tmp);
 
         mqtt->writePayload(tmp, length);
@@ -491,7 +1004,7 @@ bool HASerializer::flushTopic(const SerializerEntry* entry) const
 
     // property name
     mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
-    mqtt->writePayload(entry->property);
+    mqtt->writePayload(getEntryProperty(entry));
     mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
 
     // value (escaped)
@@ -501,20 +1014,24 @@ bool HASerializer::flushTopic(const SerializerEntry* entry) const
         const char* topic = static_cast<const char*>(entry->value);
         mqtt->writePayload(topic, strlen(topic));
     } else {
-        const uint16_t length = calculateDataTopicLength(
-            _deviceType->uniqueId(),
-            entry->property
+#ifdef ARDUINOHA_BASE_TOPIC
+        if (hasBaseTopic()) {
+            mqtt->writePayload(AHATOFSTR(HASerializerBaseTopicPrefix));
+            mqtt->writePayload(getEntryProperty(entry));
+            mqtt->writePayload(AHATOFSTR(HASerializerJsonEscapeChar));
+            return true;
+        }
+#endif
+
+        const uint16_t length = _deviceType->calculateDataTopicLength(
+            getEntryProperty(entry)
         );
         if (length == 0) {
             return false;
         }
 
         char topic[length];
-        generateDataTopic(
-            topic,
-            _deviceType->uniqueId(),
-            entry->property
-        );
+        _deviceType->generateDataTopic(topic, getEntryProperty(entry));
 
         mqtt->writePayload(topic, length - 1);
     }
@@ -536,7 +1053,7 @@ bool HASerializer::flushFlag(const SerializerEntry* entry) const
         mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
 
         // property value
-        return device->getSerializer()->flush();
+        return device->flushSerializedData();
     } else if (flag == WithUniqueId && _deviceType) {
         // property name
         mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
@@ -560,4 +1077,53 @@ bool HASerializer::flushFlag(const SerializerEntry* entry) const
     }
 
     return false;
-}
\ No newline at end of file
+}
+#ifdef ARDUINOHA_BASE_TOPIC
+uint16_t HASerializer::calculateBaseTopicSize() const
+{
+    // the data topic with an empty name ends with a slash that's not part of the base topic
+    const uint16_t length = _deviceType->calculateDataTopicLength(
+        AHATOFSTR(HASerializerEmpty)
+    );
+    if (length < 2) {
+        return 0;
+    }
+
+    return
+        // property name
+        strlen_P(HASerializerJsonPropertyPrefix) +
+        strlen_P(HABaseTopicProperty) +
+        strlen_P(HASerializerJsonPropertySuffix) +
+        // property value
+        2 * strlen_P(HASerializerJsonEscapeChar) +
+        length - 2; // exclude slash and null terminator
+}
+
+bool HASerializer::flushBaseTopic() const
+{
+    HAMqtt* mqtt = HAMqtt::instance();
+    const uint16_t length = _deviceType->calculateDataTopicLength(
+        AHATOFSTR(HASerializerEmpty)
+    );
+    if (length < 2) {
+        return false;
+    }
+
+    char topic[length];
+    if (!_deviceType->generateDataTopic(topic, AHATOFSTR(HASerializerEmpty))) {
+        return false;
+    }
+
+    // property name
+    mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertyPrefix));
+    mqtt->writePayload(AHATOFSTR(HABaseTopicProperty));
+    mqtt->writePayload(AHATOFSTR(HASerializerJsonPropertySuffix));
+
+    // value
+    mqtt->writePayload(AHATOFSTR(HASerializerJsonEscapeChar));
+    mqtt->writePayload(topic, length - 2); // exclude slash and null terminator
+    mqtt->writePayload(AHATOFSTR(HASerializerJsonEscapeChar));
+
+    return true;
+}
+#endif
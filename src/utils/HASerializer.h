@@ -5,11 +5,38 @@
 #include <stdint.h>
 
 #include "HADictionary.h"
+#include "../ArduinoHADefines.h"
 #include "HASerializerArray.h"
 
 class HAMqtt;
 class HABaseDeviceType;
 
+#if defined(ARDUINOHA_STATIC_MEMORY) && !defined(ARDUINOHA_STATIC_SERIALIZER_SIZE)
+// The number of entries of the static serializer. It needs to fit the largest device type (HAHVAC).
+// Entries that don't fit the serializer are skipped.
+#define ARDUINOHA_STATIC_SERIALIZER_SIZE 27
+#endif
+
+/// Schema row of the property whose value is returned by `getSerializerValue(field)` of the device type.
+#define HASCHEMA_PROPERTY(property, field, valueType) \
+    {HASerializer::PropertyEntryType, HASerializer::valueType, property##Key, field, 0}
+
+/// Schema row of the property that's present only if all given features of the device type are enabled.
+#define HASCHEMA_FEATURE_PROPERTY(property, field, valueType, features) \
+    {HASerializer::PropertyEntryType, HASerializer::valueType, property##Key, field, features}
+
+/// Schema row of the data topic of the device type.
+#define HASCHEMA_TOPIC(topic) \
+    {HASerializer::TopicEntryType, 0, topic##Key, 0, 0}
+
+/// Schema row of the data topic that's present only if all given features of the device type are enabled.
+#define HASCHEMA_FEATURE_TOPIC(topic, features) \
+    {HASerializer::TopicEntryType, 0, topic##Key, 0, features}
+
+/// Schema row of the flag (see HASerializer::FlagType).
+#define HASCHEMA_FLAG(flag) \
+    {HASerializer::FlagEntryType, HASerializer::flag, HANoKey, 0, 0}
+
 /**
  * This class allows to create JSON objects easily.
  * Its main purpose is to handle configuration of a device type that's going to
@@ -19,13 +46,20 @@ class HASerializer
 {
 public:
     /// Type of the object's entry.
-    enum EntryType {
+    enum EntryType : uint8_t {
         UnknownEntryType = 0,
         PropertyEntryType,
         TopicEntryType,
-        FlagEntryType
+        FlagEntryType,
+        NameEntryType
     };
 
+    /**
+     * The key of the property or topic that's not a part of the `HASerializerKeys` table.
+     * The name of such entry is stored in the preceding entry of type `NameEntryType`.
+     */
+    static const uint8_t CustomKey = UINT8_MAX;
+
     /// The type of a flag for a FlagEntryType.
     enum FlagType {
         WithDevice = 1,
@@ -43,7 +77,11 @@ public:
         ArrayPropertyType
     };
 
-    /// Representation of a single entry in the object.
+    /**
+     * Representation of a single entry in the object.
+     * The property name is stored as an index in the `HASerializerKeys` table,
+     * so the entry takes three bytes plus the value pointer.
+     */
     struct SerializerEntry {
         /// Type of the entry.
         EntryType type;
@@ -51,8 +89,8 @@ public:
         /// Subtype of the entry. It can be `FlagType`, `PropertyValueType` or `TopicType`.
         uint8_t subtype;
 
-        /// Pointer to the property name (progmem string).
-        const __FlashStringHelper* property;
+        /// Index of the property name in the `HASerializerKeys` table. Zero means that the entry has no property.
+        uint8_t key;
 
         /// Pointer to the property value. The value type is determined by `subtype`.
         const void* value;
@@ -60,11 +98,48 @@ public:
         SerializerEntry():
             type(UnknownEntryType),
             subtype(0),
-            property(nullptr),
+            key(0),
             value(nullptr)
         { }
+
+        /**
+         * Returns pointer to the property name (progmem string) or nullptr if the entry has no property.
+         * Names of the entries with `CustomKey` are resolved by HASerializer::getEntryProperty.
+         */
+        const __FlashStringHelper* getProperty() const;
+    };
+
+    /**
+     * Representation of a single entry in the schema of the JSON object.
+     * The schema is an array stored in the flash memory that describes the object of a device type at compile time.
+     * Values of properties are not part of the schema. They're resolved by the device type when the object is serialized.
+     * Use HASCHEMA_* macros to define rows of the schema.
+     */
+    struct SchemaEntry {
+        /// Type of the entry.
+        EntryType type;
+
+        /// Subtype of the entry. It can be `FlagType` or `PropertyValueType`.
+        uint8_t subtype;
+
+        /// Index of the property name in the `HASerializerKeys` table.
+        uint8_t key;
+
+        /// The field passed to `HABaseDeviceType::getSerializerValue` to resolve value of the property.
+        uint8_t field;
+
+        /// Features of the device type that need to be enabled to include the entry. Zero means that the entry is always included.
+        uint16_t features;
     };
 
+    /**
+     * Returns index of the given property in the `HASerializerKeys` table.
+     * Zero is returned if the property is not a part of the dictionary.
+     *
+     * @param property The property name (progmem string from HADictionary).
+     */
+    static uint8_t findKey(const __FlashStringHelper* property);
+
     /**
      * Calculates the size of a configuration topic for the given component and object ID.
      * The configuration topic has structure as follows: `[discovery prefix]/[component]/[device ID]_[objectId]/config`
@@ -121,6 +196,7 @@ public:
      * Checks whether the given topic matches the data topic that can be generated
      * using the given objectId and topicP.
      * This method can be used to check if the received message matches some data topic.
+     * The expected topic is not generated. The given topic is compared segment by segment instead.
      *
      * @param actualTopic The actual topic to compare.
      * @param objectId The unique ID of a device type that may be the owner of the topic.
@@ -132,6 +208,38 @@ public:
         const __FlashStringHelper* topic
     );
 
+    /**
+     * Matches the prefix of the data topic (`[data prefix]/[device ID]/[objectId]/`) with the given topic.
+     * It allows to compare the remaining part of the topic with many topic names without repeating
+     * the comparison of the prefix.
+     *
+     * @param actualTopic The actual topic to match.
+     * @param objectId The unique ID of a device type that may be the owner of the topic.
+     * @returns Pointer to the topic name in the `actualTopic` or nullptr if the prefix doesn't match.
+     */
+    static const char* matchDataTopicPrefix(
+        const char* actualTopic,
+        const char* objectId
+    );
+
+    /**
+     * Splits the given topic into the object ID and the topic name if it's a data topic
+     * of the current device. The expected structure is: `[data prefix]/[device ID]/[objectId]/[topic]`
+     * This method doesn't allocate any memory. Returned pointers point to the given `actualTopic`.
+     *
+     * @param actualTopic The actual topic to split.
+     * @param objectId Pointer to the beginning of the object ID (it's not null terminated).
+     * @param objectIdLength Length of the object ID.
+     * @param topic Pointer to the topic name (the last segment of the topic).
+     * @returns Returns `true` if the given topic is a data topic of an object that belongs to the current device.
+     */
+    static bool splitDataTopic(
+        const char* actualTopic,
+        const char** objectId,
+        uint16_t* objectIdLength,
+        const char** topic
+    );
+
     /**
      * Creates instance of the serializer for the given device type.
      * Please note that the number JSON object's entries needs to be known upfront.
@@ -142,25 +250,78 @@ public:
      */
     HASerializer(HABaseDeviceType* deviceType, const uint8_t maxEntriesNb);
 
+    /**
+     * Creates instance of the serializer that uses the given storage for the entries.
+     *
+     * @param deviceType The device type that owns the serializer.
+     * @param entries The storage for the entries.
+     * @param maxEntriesNb The size of the storage.
+     */
+    HASerializer(
+        HABaseDeviceType* deviceType,
+        SerializerEntry* entries,
+        const uint8_t maxEntriesNb
+    );
+
+    /**
+     * Creates instance of the serializer that walks the given schema instead of the entries.
+     * The serializer doesn't allocate any memory and entries cannot be added using `set` and `topic` methods.
+     *
+     * @param deviceType The device type that owns the serializer. It resolves values of the properties.
+     * @param schema The schema of the JSON object (array stored in the flash memory).
+     * @param schemaSize The number of rows in the schema.
+     * @param features Features enabled for the device type. Rows with other features are skipped.
+     */
+    HASerializer(
+        HABaseDeviceType* deviceType,
+        const SchemaEntry* schema,
+        const uint8_t schemaSize,
+        const uint16_t features
+    );
+
+    /**
+     * Returns the storage shared by serializers of the device types.
+     * Device types build their serializers one at a time (between `buildSerializer` and `destroySerializer`),
+     * so the same memory is reused for each of them and no allocation is made on reconnect.
+     * Entries of the shared serializer grow to the size of the largest serializer.
+     * If the shared storage is already in use, the serializer is allocated on the heap
+     * (or the nullptr is returned if `ARDUINOHA_STATIC_MEMORY` is defined).
+     */
+    static void* operator new(size_t size) noexcept;
+
+    /**
+     * Releases the shared storage or frees the memory allocated on the heap.
+     */
+    static void operator delete(void* ptr) noexcept;
+
+    /**
+     * Frees entries of the shared serializer.
+     * It's called when the HAMqtt instance is destroyed.
+     */
+    static void releaseSharedStorage();
+
     /**
      * Frees the dynamic memory allocated by the class.
      */
     ~HASerializer();
 
     /**
-     * Returns the number of items that were added to the serializer.
+     * Returns the number of items that were added to the serializer
+     * or the number of rows in the schema.
      */
     inline uint8_t getEntriesNb() const
         { return _entriesNb; }
 
     /**
      * Returns pointer to the serializer's entries.
+     * It's nullptr if the serializer walks a schema.
      */
     inline SerializerEntry* getEntries() const
         { return _entries; }
 
     /**
      * Adds a new entry to the serialized with a type of `PropertyEntryType`.
+     * Properties that are not a part of the dictionary (`HASerializerKeys`) take two entries.
      *
      * @param property Pointer to the name of the property (progmem string).
      * @param value Pointer to the value that's being set.
@@ -172,6 +333,20 @@ public:
         PropertyValueType valueType = ConstCharPropertyValue
     );
 
+    /**
+     * Replaces value of the property that's already set or adds a new entry otherwise.
+     * It's used by the HADevice whose setters may be called many times.
+     *
+     * @param property Pointer to the name of the property (progmem string).
+     * @param value Pointer to the value that's being set.
+     * @param valueType The type of the value that's passed to the method.
+     */
+    void update(
+        const __FlashStringHelper* property,
+        const void* value,
+        PropertyValueType valueType = ConstCharPropertyValue
+    );
+
     /**
      * Adds a new entry to the serializer with a type of `FlagEntryType`.
      *
@@ -188,17 +363,56 @@ public:
 
     /**
      * Calculates the output size of the serialized JSON object.
+     *
+     * @param withPlatform Specifies whether the platform (`p` property) of the device type
+     *                     should be included. It's used by the device-level discovery.
      */
-    uint16_t calculateSize() const;
+    uint16_t calculateSize(const bool withPlatform = false) const;
 
     /**
      * Flushes the JSON object to the MQTT stream.
      * Please note that this method only writes the MQTT payload.
      * The MQTT session needs to be opened before.
+     *
+     * @param withPlatform Specifies whether the platform (`p` property) of the device type
+     *                     should be included. It's used by the device-level discovery.
+     */
+    bool flush(const bool withPlatform = false) const;
+
+    /**
+     * Serializes the JSON object to the staging buffer of the HAMqtt in a single pass.
+     * The returned length is larger than the size of the buffer if the object doesn't fit.
+     * In this case the object needs to be streamed using HASerializer::flush method.
+     *
+     * @returns The length of the object or zero if the staging buffer is not set.
      */
-    bool flush() const;
+    uint16_t stage() const;
+
+    /**
+     * Calculates hash of the JSON object and the given topic.
+     * The object is flushed to the HAMqtt in the hashing mode, so nothing is written to the MQTT stream.
+     *
+     * @param topic The topic on which the object is going to be published.
+     * @returns The hash or zero if the object couldn't be serialized.
+     */
+    uint32_t calculateHash(const char* topic) const;
 
 private:
+    /**
+     * Compares beginning of the given topic with the segment.
+     * The comparison stops on the first byte that differs.
+     *
+     * @param actualTopic The topic to compare. It can be nullptr.
+     * @param segment The expected segment of the topic.
+     * @param progmemSegment Specifies whether the segment is stored in the flash memory.
+     * @returns Pointer to the first character after the segment or nullptr if the segment doesn't match.
+     */
+    static const char* matchTopicSegment(
+        const char* actualTopic,
+        const char* segment,
+        const bool progmemSegment = false
+    );
+
     /// Pointer to the device type that owns the serializer.
     HABaseDeviceType* _deviceType;
 
@@ -211,12 +425,88 @@ private:
     /// Pointer to the serializer entries.
     SerializerEntry* _entries;
 
+    /// Specifies whether the entries were allocated by the serializer.
+    bool _ownsEntries;
+
+    /// Pointer to the schema (flash memory) or nullptr if the serializer uses entries.
+    const SchemaEntry* _schema;
+
+    /// Features of the device type that are used for filtering the schema.
+    uint16_t _features;
+
+    /// The number of entries that point to data topics of the device type.
+    uint8_t _dataTopicsNb;
+
+#ifdef ARDUINOHA_BASE_TOPIC
+    /**
+     * Returns `true` if data topics should be shortened using the base topic (`~`).
+     * The base topic is used only if it makes the output smaller.
+     */
+    inline bool hasBaseTopic() const
+        { return _deviceType && _dataTopicsNb > 1; }
+
+    /**
+     * Calculates the size of the base topic property (`"~":"[data prefix]/[device ID]/[object ID]"`).
+     */
+    uint16_t calculateBaseTopicSize() const;
+
+    /**
+     * Flushes the base topic property to the MQTT.
+     */
+    bool flushBaseTopic() const;
+#endif
+
+    /**
+     * Calculates the size of the platform property (`"p":"[component name]"`).
+     */
+    uint16_t calculatePlatformSize() const;
+
+    /**
+     * Flushes the platform property to the MQTT.
+     */
+    void flushPlatform() const;
+
+    /**
+     * Returns the entry with the given index or nullptr if the entry is not present in the output.
+     * The entry of the schema is resolved into the given storage.
+     *
+     * @param index Index of the entry.
+     * @param storage Storage for the resolved entry of the schema.
+     */
+    const SerializerEntry* getEntry(const uint8_t index, SerializerEntry& storage) const;
+
+    /**
+     * Returns the name of the given entry (progmem string) or nullptr if the entry has no name.
+     * The name of the entry with `CustomKey` is read from the preceding `NameEntryType` entry of this serializer.
+     *
+     * @param entry The entry returned by HASerializer::getEntry.
+     */
+    const __FlashStringHelper* getEntryProperty(const SerializerEntry* entry) const;
+
+    /**
+     * Resolves the flag entry into the entry that's going to be serialized.
+     * The flag may be converted into the topic (availability).
+     *
+     * @param entry The entry of type `FlagEntryType`.
+     * @returns Returns `false` if the flag should be skipped.
+     */
+    bool resolveFlag(SerializerEntry& entry) const;
+
     /**
      * Creates a new entry in the serializer's memory.
      * If the limit of entries is hit, the nullptr is returned.
      */
     SerializerEntry* addEntry();
 
+    /**
+     * Creates a new entry for the given property or topic and sets its key.
+     * If the name is not a part of the dictionary, the additional `NameEntryType` entry is created before.
+     * If the limit of entries is hit, the nullptr is returned.
+     *
+     * @param name The name of the property or topic (progmem string).
+     */
+    SerializerEntry* addEntry(const __FlashStringHelper* name);
+
     /**
      * Calculates the serialized size of the given entry.
      * Internally, this method recognizes the type of the entry and calls
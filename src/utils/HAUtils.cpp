@@ -46,3 +46,22 @@ char* HAUtils::byteArrayToStr(
 
     return dst;
 }
+
+uint32_t HAUtils::calculateHash(
+    uint32_t hash,
+    const uint8_t* data,
+    const uint16_t length,
+    const bool isProgmemData
+)
+{
+    if (!data) {
+        return hash;
+    }
+
+    for (uint16_t i = 0; i < length; i++) {
+        hash ^= isProgmemData ? pgm_read_byte(&data[i]) : data[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
@@ -9,6 +9,9 @@
 class HAUtils
 {
 public:
+    /// The initial value of the hash calculated by HAUtils::calculateHash method.
+    static const uint32_t HashSeed = 2166136261UL;
+
     /**
      * Checks whether the given `str` ends with the given `suffix`.
      *
@@ -47,6 +50,23 @@ public:
         const byte* src,
         const uint16_t length
     );
+
+    /**
+     * Updates the given hash with the bytes array (32-bit FNV-1a).
+     * The hash can be calculated incrementally, so the data doesn't need to be present in RAM at once.
+     *
+     * @param hash The current hash. Use HAUtils::HashSeed for the first chunk of data.
+     * @param data Bytes array to hash.
+     * @param length Length of the bytes array.
+     * @param isProgmemData Specifies whether the given data is stored in the flash memory.
+     * @returns The updated hash.
+     */
+    static uint32_t calculateHash(
+        uint32_t hash,
+        const uint8_t* data,
+        const uint16_t length,
+        const bool isProgmemData = false
+    );
 };
 
 #endif
@@ -0,0 +1,140 @@
+#include <AUnit.h>
+#include <ArduinoHA.h>
+
+#define assertAllocationStats(operation, expectedAllocationsNb, expectedAllocatedBytes) \
+{ \
+    const HAAllocationStats& stats = mqtt.getAllocationStats(operation); \
+    assertEqual((uint32_t)expectedAllocationsNb, stats.allocationsNb); \
+    assertEqual((uint32_t)expectedAllocatedBytes, stats.allocatedBytes); \
+}
+
+using aunit::TestRunner;
+
+static const char* testDeviceId = "testDevice";
+
+AHA_TEST(AllocationStatsTest, initial_stats) {
+    initMqttTest(testDeviceId)
+
+    mqtt.resetAllocationStats();
+
+    assertAllocationStats(HAMqtt::OperationOther, 0, 0)
+    assertAllocationStats(HAMqtt::OperationConnect, 0, 0)
+    assertAllocationStats(HAMqtt::OperationMessage, 0, 0)
+}
+
+AHA_TEST(AllocationStatsTest, connect_allocations) {
+    initMqttTest(testDeviceId)
+
+    HASwitch lightSwitch("uniqueSwitch");
+    HASensor sensor("uniqueSensor");
+    mqtt.resetAllocationStats();
+
+    const uint32_t heapBytes = mqtt.getHeapBytes();
+    mqtt.loop();
+
+    // entries of the shared serializer grow to 11 (switch), the sensor's schema is stored in the flash memory
+    const uint32_t entrySize = sizeof(HASerializer::SerializerEntry);
+    assertAllocationStats(HAMqtt::OperationConnect, 1, 11 * entrySize)
+    assertEqual(heapBytes + 11 * entrySize, mqtt.getHeapBytes());
+    assertAllocationStats(HAMqtt::OperationOther, 0, 0)
+}
+
+AHA_TEST(AllocationStatsTest, schema_connect_allocations) {
+    initMqttTest(testDeviceId)
+
+    HASensor sensor("uniqueSensor");
+    HALight light("uniqueLight", HALight::BrightnessFeature | HALight::RGBFeature);
+    mqtt.resetAllocationStats();
+
+    const uint32_t heapBytes = mqtt.getHeapBytes();
+    mqtt.loop();
+
+    assertAllocationStats(HAMqtt::OperationConnect, 0, 0)
+    assertEqual(heapBytes, mqtt.getHeapBytes());
+}
+
+AHA_TEST(AllocationStatsTest, reconnect_allocations) {
+    initMqttTest(testDeviceId)
+
+    HASensor sensor("uniqueSensor");
+    HASwitch lightSwitch("uniqueSwitch");
+    mqtt.loop();
+    mqtt.resetAllocationStats();
+
+    const uint32_t heapBytes = mqtt.getHeapBytes();
+    mock->clearFlushedMessages();
+    mock->clearSubscriptions();
+    mqtt.disconnect();
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+
+    assertAllocationStats(HAMqtt::OperationConnect, 0, 0)
+    assertEqual(heapBytes, mqtt.getHeapBytes());
+}
+
+AHA_TEST(AllocationStatsTest, message_allocations) {
+    initMqttTest(testDeviceId)
+
+    HASwitch lightSwitch("uniqueSwitch");
+    mqtt.loop();
+    mqtt.resetAllocationStats();
+
+    mock->fakeMessage("testData/testDevice/uniqueSwitch/cmd_t", "ON");
+
+    assertAllocationStats(HAMqtt::OperationMessage, 0, 0)
+}
+
+AHA_TEST(AllocationStatsTest, other_allocations) {
+    initMqttTest(testDeviceId)
+
+    HASelect select("uniqueSelect");
+    mqtt.resetAllocationStats();
+
+    const uint32_t heapBytes = mqtt.getHeapBytes();
+    select.setOptions("A;B;C");
+
+    const HAAllocationStats& stats = mqtt.getAllocationStats(HAMqtt::OperationOther);
+    assertMore(stats.allocationsNb, (uint32_t)0);
+    assertEqual(heapBytes + stats.allocatedBytes, mqtt.getHeapBytes());
+    assertAllocationStats(HAMqtt::OperationConnect, 0, 0)
+}
+
+AHA_TEST(AllocationStatsTest, select_options_allocations) {
+    initMqttTest(testDeviceId)
+
+    char options[512] = {0};
+    for (uint8_t i = 0; i < 100; i++) {
+        sprintf(&options[strlen(options)], i == 0 ? "P%u" : ";P%u", i);
+    }
+
+    HASelect select("uniqueSelect");
+    mqtt.resetAllocationStats();
+    select.setOptions(options);
+
+    // the options' buffer, the serializer's array and its items
+    const HAAllocationStats& stats = mqtt.getAllocationStats(HAMqtt::OperationOther);
+    assertEqual((uint32_t)3, stats.allocationsNb);
+}
+
+AHA_TEST(AllocationStatsTest, mock_allocations_excluded) {
+    initMqttTest(testDeviceId)
+
+    mqtt.loop();
+    mqtt.resetAllocationStats();
+    mqtt.publish("testTopic", "testPayload");
+
+    assertAllocationStats(HAMqtt::OperationOther, 0, 0)
+}
+
+void setup()
+{
+    delay(1000);
+    Serial.begin(115200);
+    while (!Serial);
+}
+
+void loop()
+{
+    TestRunner::run();
+    delay(1);
+}
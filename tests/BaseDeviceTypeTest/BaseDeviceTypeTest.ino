@@ -5,6 +5,31 @@
     initMqttTest(testDeviceId) \
     DummyDeviceType deviceType(AHATOFSTR(ComponentNameStr), testUniqueId);
 
+#define prepareCacheTest(cacheMode) \
+    PubSubClientMock* mock = new PubSubClientMock(); \
+    HADevice device(testDeviceId); \
+    HAMqtt mqtt(mock, device); \
+    mqtt.setDataPrefix("testData"); \
+    mqtt.setTopicsCacheMode(cacheMode); \
+    DummyTopicsDeviceType deviceType(AHATOFSTR(ComponentNameStr), testUniqueId); \
+    mqtt.begin("testHost", "testUser", "testPass");
+
+#define assertTopicsCacheMessages() \
+    mqtt.loop(); \
+    assertEqual((uint8_t)2, mock->getFlushedMessagesNb()); \
+    assertMqttMessage(0, AHATOFSTR(ConfigTopic), "{\"stat_t\":\"testData/testDevice/uniqueId/stat_t\"}", true) \
+    assertMqttMessage(1, AHATOFSTR(StateTopic), "ON", false) \
+    assertEqual((uint8_t)1, mock->getSubscriptionsNb()); \
+    assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
+
+#define assertSensorConfig() \
+    assertMqttMessage( \
+        0, \
+        "homeassistant/sensor/testDevice/uniqueId/config", \
+        "{\"uniq_id\":\"uniqueId\",\"dev\":{\"ids\":\"testDevice\"},\"stat_t\":\"testData/testDevice/uniqueId/stat_t\"}", \
+        true \
+    )
+
 using aunit::TestRunner;
 
 static const char* testDeviceId = "testDevice";
@@ -13,6 +38,9 @@ static const char* testUniqueId = "uniqueId";
 const char AvailabilityTopic[] PROGMEM = {"testData/testDevice/uniqueId/avty_t"};
 const char SharedAvailabilityTopic[] PROGMEM = {"testData/testDevice/avty_t"};
 const char ComponentNameStr[] PROGMEM = {"componentName"};
+const char ConfigTopic[] PROGMEM = {"homeassistant/componentName/testDevice/uniqueId/config"};
+const char StateTopic[] PROGMEM = {"testData/testDevice/uniqueId/stat_t"};
+const char CommandTopic[] PROGMEM = {"testData/testDevice/uniqueId/cmd_t"};
 
 class DummyDeviceType : public HABaseDeviceType
 {
@@ -26,6 +54,25 @@ protected:
     }
 };
 
+class DummyTopicsDeviceType : public HABaseDeviceType
+{
+public:
+    DummyTopicsDeviceType(const __FlashStringHelper* componentName, const char* uniqueId) :
+        HABaseDeviceType(componentName, uniqueId) { }
+
+protected:
+    virtual void buildSerializer() override {
+        _serializer = new HASerializer(this, 1);
+        _serializer->topic(AHATOFSTR(HAStateTopic));
+    }
+
+    virtual void onMqttConnected() override {
+        publishConfig();
+        publishOnDataTopic(AHATOFSTR(HAStateTopic), "ON");
+        subscribeTopic(uniqueId(), AHATOFSTR(HACommandTopic));
+    }
+};
+
 AHA_TEST(BaseDeviceTypeTest, constructor_params) {
     DummyDeviceType deviceType(AHATOFSTR(ComponentNameStr), testUniqueId);
     assertEqual(AHATOFSTR(ComponentNameStr), deviceType.componentName());
@@ -106,6 +153,126 @@ AHA_TEST(BaseDeviceTypeTest, publish_shared_availability_runtime) {
     assertSingleMqttMessage(AHATOFSTR(SharedAvailabilityTopic), "offline", true)
 }
 
+AHA_TEST(BaseDeviceTypeTest, topics_cache_disabled) {
+    prepareCacheTest(HAMqtt::TopicsCacheDisabled)
+    assertTopicsCacheMessages()
+}
+
+AHA_TEST(BaseDeviceTypeTest, topics_cache_lengths) {
+    prepareCacheTest(HAMqtt::TopicsCacheLengths)
+    assertTopicsCacheMessages()
+}
+
+AHA_TEST(BaseDeviceTypeTest, topics_cache_full) {
+    prepareCacheTest(HAMqtt::TopicsCacheFull)
+    assertTopicsCacheMessages()
+}
+
+AHA_TEST(BaseDeviceTypeTest, topics_cache_data_topic_length) {
+    prepareCacheTest(HAMqtt::TopicsCacheLengths)
+
+    assertEqual(
+        (uint16_t)(strlen_P(StateTopic) + 1),
+        deviceType.calculateDataTopicLength(AHATOFSTR(HAStateTopic))
+    );
+}
+
+AHA_TEST(BaseDeviceTypeTest, staged_config) {
+    initMqttTest(testDeviceId)
+
+    char buffer[128];
+    mqtt.setStagingBuffer(buffer, sizeof(buffer));
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    assertSensorConfig()
+    assertEqual((uint16_t)1, mqtt.getStagedPayloadsNb());
+    assertEqual((uint16_t)0, mqtt.getStreamedPayloadsNb());
+}
+
+AHA_TEST(BaseDeviceTypeTest, streamed_config) {
+    initMqttTest(testDeviceId)
+
+    char buffer[16];
+    mqtt.setStagingBuffer(buffer, sizeof(buffer));
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    assertSensorConfig()
+    assertEqual((uint16_t)0, mqtt.getStagedPayloadsNb());
+    assertEqual((uint16_t)1, mqtt.getStreamedPayloadsNb());
+    assertEqual((uint16_t)96, mqtt.getLargestStreamedPayloadSize());
+}
+
+AHA_TEST(BaseDeviceTypeTest, staged_config_with_device_cache) {
+    initMqttTest(testDeviceId)
+
+    char buffer[128];
+    mqtt.setStagingBuffer(buffer, sizeof(buffer));
+    device.enableSerializerCache();
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    assertSensorConfig()
+    assertEqual((uint16_t)1, mqtt.getStagedPayloadsNb());
+}
+
+AHA_TEST(BaseDeviceTypeTest, staged_config_with_config_cache) {
+    initMqttTest(testDeviceId)
+
+    char buffer[128];
+    mqtt.setStagingBuffer(buffer, sizeof(buffer));
+    mqtt.enableConfigCache();
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    assertSensorConfig()
+
+    mock->clearFlushedMessages();
+    mqtt.disconnect();
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+
+    assertNoMqttMessage()
+    assertEqual((uint16_t)2, mqtt.getStagedPayloadsNb());
+}
+
+AHA_TEST(BaseDeviceTypeTest, buffered_config) {
+    initMqttTest(testDeviceId)
+
+    mqtt.enableWriteBuffer();
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    assertSensorConfig()
+    assertEqual((uint16_t)1, mock->getWritesNb());
+}
+
+AHA_TEST(BaseDeviceTypeTest, buffered_config_small_buffer) {
+    initMqttTest(testDeviceId)
+
+    mqtt.enableWriteBuffer(16);
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    assertSensorConfig()
+    assertEqual((uint16_t)6, mock->getWritesNb());
+}
+
+AHA_TEST(BaseDeviceTypeTest, buffered_staged_config) {
+    initMqttTest(testDeviceId)
+
+    char buffer[128];
+    mqtt.setStagingBuffer(buffer, sizeof(buffer));
+    mqtt.enableWriteBuffer(16);
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    assertSensorConfig()
+    assertEqual((uint16_t)1, mqtt.getStagedPayloadsNb());
+    assertEqual((uint16_t)1, mock->getWritesNb());
+}
+
 void setup()
 {
     delay(1000);
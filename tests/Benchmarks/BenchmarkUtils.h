@@ -0,0 +1,109 @@
+#ifndef AHA_BENCHMARKUTILS_H
+#define AHA_BENCHMARKUTILS_H
+
+#include <Arduino.h>
+
+/**
+ * Results are printed as CSV lines in the following format: `benchmark,case,metric,value`.
+ * The `make runbenchmarks` target prints the header line before running the benchmarks,
+ * so the output of all benchmarks can be stored in a single file and compared between releases.
+ */
+
+inline void printBenchmarkResult(
+    const __FlashStringHelper* benchmark,
+    const __FlashStringHelper* caseName,
+    const __FlashStringHelper* metric,
+    const uint32_t value
+)
+{
+    Serial.print(benchmark);
+    Serial.print(F(","));
+    Serial.print(caseName);
+    Serial.print(F(","));
+    Serial.print(metric);
+    Serial.print(F(","));
+    Serial.println(value);
+}
+
+inline void printBenchmarkResult(
+    const __FlashStringHelper* benchmark,
+    const uint32_t caseValue,
+    const __FlashStringHelper* metric,
+    const uint32_t value
+)
+{
+    Serial.print(benchmark);
+    Serial.print(F(","));
+    Serial.print(caseValue);
+    Serial.print(F(","));
+    Serial.print(metric);
+    Serial.print(F(","));
+    Serial.println(value);
+}
+
+/**
+ * Returns the average time of a single iteration in nanoseconds.
+ */
+inline uint32_t calculateNsPerIteration(
+    const uint32_t startMicros,
+    const uint32_t iterationsNb
+)
+{
+    const uint64_t elapsedNs = static_cast<uint64_t>(micros() - startMicros) * 1000;
+    return static_cast<uint32_t>(elapsedNs / iterationsNb);
+}
+
+/// The minimum number of timed runs of each measurement.
+#define BENCHMARK_RUNS_NB 15
+
+/// The minimum total time of each measurement (milliseconds).
+#define BENCHMARK_MIN_TIME_MS 200
+
+/**
+ * Calls the given function `iterationsNb` times in each of the timed runs
+ * and returns the average time of a single iteration (in nanoseconds) in the fastest run.
+ * Runs are repeated until there are at least BENCHMARK_RUNS_NB of them and BENCHMARK_MIN_TIME_MS passes.
+ * Interruptions of the process (e.g. by the OS scheduler) only make runs slower,
+ * so the fastest run is stable between executions of the benchmark.
+ *
+ * @param iterationsNb The number of iterations in a single run.
+ * @param function The measured function (e.g. a lambda) that performs a single iteration.
+ */
+template <typename Function>
+inline uint32_t measureNsPerIteration(const uint32_t iterationsNb, Function function)
+{
+    uint32_t fastestNs = UINT32_MAX;
+    const uint32_t startMillis = millis();
+
+    for (
+        uint32_t run = 0;
+        run < BENCHMARK_RUNS_NB || millis() - startMillis < BENCHMARK_MIN_TIME_MS;
+        run++
+    ) {
+        const uint32_t startMicros = micros();
+
+        for (uint32_t i = 0; i < iterationsNb; i++) {
+            function();
+        }
+
+        const uint32_t ns = calculateNsPerIteration(startMicros, iterationsNb);
+        if (ns < fastestNs) {
+            fastestNs = ns;
+        }
+    }
+
+    return fastestNs;
+}
+
+inline void finishBenchmark()
+{
+#if defined(EPOXY_DUINO)
+    exit(0);
+#else
+    while (true) {
+        delay(1000);
+    }
+#endif
+}
+
+#endif
@@ -0,0 +1,56 @@
+#include <ArduinoHA.h>
+#include "../BenchmarkUtils.h"
+
+#define BENCHMARK_NAME F("connect")
+
+static const char* testDeviceId = "testDevice";
+
+static void printResults(const __FlashStringHelper* caseName, HAMqtt& mqtt)
+{
+    const HAAllocationStats& stats = mqtt.getAllocationStats(HAMqtt::OperationConnect);
+
+    printBenchmarkResult(BENCHMARK_NAME, caseName, F("allocations"), stats.allocationsNb);
+    printBenchmarkResult(BENCHMARK_NAME, caseName, F("allocated_bytes"), stats.allocatedBytes);
+    printBenchmarkResult(BENCHMARK_NAME, caseName, F("peak_heap_bytes"), stats.peakHeapBytes);
+    printBenchmarkResult(BENCHMARK_NAME, caseName, F("heap_bytes_after"), mqtt.getHeapBytes());
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    PubSubClientMock* mock = new PubSubClientMock();
+    HADevice device(testDeviceId);
+    HAMqtt mqtt(mock, device);
+    mqtt.setDataPrefix("testData");
+
+    HASensor temperature("temperature");
+    HASensorNumber humidity("humidity", HASensorNumber::PrecisionP1);
+    HABinarySensor door("door");
+    HASwitch relay("relay");
+    HALight light("light", HALight::BrightnessFeature);
+    HAHVAC hvac("hvac", HAHVAC::TargetTemperatureFeature);
+    HASelect mode("mode");
+    mode.setOptions("Auto;Manual;Off");
+
+    mqtt.resetAllocationStats();
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+    printResults(F("first_connect"), mqtt);
+
+    mock->clearFlushedMessages();
+    mock->clearSubscriptions();
+    mqtt.disconnect();
+
+    mqtt.resetAllocationStats();
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+    printResults(F("reconnect"), mqtt);
+
+    finishBenchmark();
+}
+
+void loop()
+{
+
+}
@@ -0,0 +1,100 @@
+#include <ArduinoHA.h>
+#include "../BenchmarkUtils.h"
+
+#define BENCHMARK_NAME F("HANumeric")
+#define ITERATIONS_NB 200000
+
+// prevents the compiler from optimizing out the measured calls
+static volatile uint32_t sink = 0;
+
+static void benchmarkFormat(
+    const __FlashStringHelper* caseName,
+    const HANumeric& number
+)
+{
+    char buffer[HANumeric::MaxStrLength + 1];
+
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        caseName,
+        F("ns_per_size"),
+        measureNsPerIteration(ITERATIONS_NB, [&]() {
+            sink += number.calculateSize();
+        })
+    );
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        caseName,
+        F("ns_per_format"),
+        measureNsPerIteration(ITERATIONS_NB, [&]() {
+            sink += number.toStr(buffer);
+        })
+    );
+}
+
+static void benchmarkParse(
+    const __FlashStringHelper* caseName,
+    const char* str
+)
+{
+    const uint8_t* buffer = reinterpret_cast<const uint8_t*>(str);
+    const uint16_t length = strlen(str);
+
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        caseName,
+        F("ns_per_parse"),
+        measureNsPerIteration(ITERATIONS_NB, [&]() {
+            sink += HANumeric::fromStr(buffer, length).isSet();
+        })
+    );
+}
+
+static void benchmarkDecimalParse(
+    const __FlashStringHelper* caseName,
+    const char* str,
+    const uint8_t precision
+)
+{
+    const uint8_t* buffer = reinterpret_cast<const uint8_t*>(str);
+    const uint16_t length = strlen(str);
+
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        caseName,
+        F("ns_per_parse"),
+        measureNsPerIteration(ITERATIONS_NB, [&]() {
+            sink += HANumeric::fromStr(buffer, length, precision).isSet();
+        })
+    );
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    printBenchmarkResult(BENCHMARK_NAME, F("all"), F("bytes"), sizeof(HANumeric));
+
+    benchmarkFormat(F("uint8_p0"), HANumeric((uint8_t)123, 0));
+    benchmarkFormat(F("int16_p1"), HANumeric((int16_t)-1234, 1));
+    benchmarkFormat(F("int32_p0"), HANumeric((int32_t)-123456789, 0));
+    benchmarkFormat(F("uint32_p3"), HANumeric((uint32_t)4000000000UL, 3));
+    benchmarkFormat(F("float_p2"), HANumeric(123.45f, 2));
+
+    benchmarkParse(F("short"), "12");
+    benchmarkParse(F("negative"), "-1234");
+    benchmarkParse(F("int32"), "-2147483648");
+    benchmarkParse(F("int64"), "9223372036854775807");
+    benchmarkParse(F("invalid"), "12a");
+
+    benchmarkDecimalParse(F("decimal_p1"), "21.5", 1);
+    benchmarkDecimalParse(F("decimal_p3"), "-12345.678", 3);
+    benchmarkDecimalParse(F("decimal_long_p2"), "1234567890.12", 2);
+
+    finishBenchmark();
+}
+
+void loop()
+{
+
+}
@@ -0,0 +1,93 @@
+#include <ArduinoHA.h>
+#include "../BenchmarkUtils.h"
+
+#define BENCHMARK_NAME F("processMessage")
+#define ITERATIONS_NB 10000
+
+static const char* testDeviceId = "testDevice";
+static const uint8_t entitiesNbCases[] = {1, 8, 32, 64, 128, 255};
+
+static void onSwitchCommand(bool state, HASwitch* sender)
+{
+    sender->setState(state);
+}
+
+static uint32_t measureProcessMessage(HAMqtt& mqtt, const char* topic)
+{
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>("ON");
+
+    return measureNsPerIteration(ITERATIONS_NB, [&]() {
+        mqtt.processMessage(topic, payload, 2);
+    });
+}
+
+static void runBenchmark(const uint8_t entitiesNb)
+{
+    PubSubClientMock* mock = new PubSubClientMock();
+    HADevice device(testDeviceId);
+    HAMqtt mqtt(mock, device, entitiesNb);
+    mqtt.setDataPrefix("testData");
+
+    char (*uniqueIds)[8] = new char[entitiesNb][8];
+    HASwitch** switches = new HASwitch*[entitiesNb];
+
+    for (uint16_t i = 0; i < entitiesNb; i++) {
+        sprintf(uniqueIds[i], "s%u", i);
+        switches[i] = new HASwitch(uniqueIds[i]);
+        switches[i]->onCommand(onSwitchCommand);
+    }
+
+    // the mock can't hold more than 255 messages, so the configs are published in parts
+    mqtt.setConnectPacing(4096);
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+    mock->setState(HAMqtt::StateConnected);
+
+    while (!mqtt.isConnectPhaseFinished()) {
+        mock->clearFlushedMessages();
+        mqtt.loop();
+    }
+
+    // the worst case: the last registered entity owns the topic
+    char commandTopic[64];
+    sprintf(commandTopic, "testData/%s/%s/cmd_t", testDeviceId, uniqueIds[entitiesNb - 1]);
+
+    // the message that doesn't belong to any data topic is passed to all entities
+    const char* foreignTopic = "homeassistant/status";
+
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        entitiesNb,
+        F("ns_per_command"),
+        measureProcessMessage(mqtt, commandTopic)
+    );
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        entitiesNb,
+        F("ns_per_foreign_message"),
+        measureProcessMessage(mqtt, foreignTopic)
+    );
+
+    for (uint16_t i = 0; i < entitiesNb; i++) {
+        delete switches[i];
+    }
+
+    delete[] switches;
+    delete[] uniqueIds;
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    for (uint8_t i = 0; i < sizeof(entitiesNbCases); i++) {
+        runBenchmark(entitiesNbCases[i]);
+    }
+
+    finishBenchmark();
+}
+
+void loop()
+{
+
+}
@@ -0,0 +1,114 @@
+#include <ArduinoHA.h>
+#include "../BenchmarkUtils.h"
+
+#define BENCHMARK_NAME F("publishConfig")
+#define ITERATIONS_NB 2000
+
+#define benchmarkConfig(caseName, deviceTypeDefinition) \
+{ \
+    PubSubClientMock* mock = new PubSubClientMock(); \
+    HADevice device(testDeviceId); \
+    HAMqtt mqtt(mock, device); \
+    mqtt.setDataPrefix("testData"); \
+    deviceTypeDefinition; \
+    mqtt.resetAllocationStats(); \
+    mqtt.begin("testHost", "testUser", "testPass"); \
+    mqtt.loop(); \
+    runBenchmark(F(caseName), mqtt, mock); \
+}
+
+static const char* testDeviceId = "testDevice";
+static const char* testUniqueId = "uniqueId";
+
+static void runBenchmark(
+    const __FlashStringHelper* caseName,
+    HAMqtt& mqtt,
+    PubSubClientMock* mock
+)
+{
+    // the shared serializer grows to the size of the device type's serializer on the first connect
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        caseName,
+        F("serializer_bytes"),
+        sizeof(HASerializer) + mqtt.getAllocationStats(HAMqtt::OperationConnect).allocatedBytes
+    );
+
+    mock->clearFlushedMessages();
+    mqtt.republishConfigs();
+
+    if (mock->getFlushedMessagesNb() == 0) {
+        return;
+    }
+
+    const MqttMessage* config = mock->getFlushedMessages()[0];
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        caseName,
+        F("bytes"),
+        strlen(config->topic) + strlen(config->buffer)
+    );
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        caseName,
+        F("writes"),
+        mock->getWritesNb()
+    );
+
+    // the time includes the mock's bookkeeping of the flushed messages
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        caseName,
+        F("ns_per_publish"),
+        measureNsPerIteration(ITERATIONS_NB, [&]() {
+            mock->clearFlushedMessages();
+            mqtt.republishConfigs();
+        })
+    );
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        F("all"),
+        F("entry_bytes"),
+        sizeof(HASerializer::SerializerEntry)
+    );
+
+    benchmarkConfig("binary_sensor", HABinarySensor deviceType(testUniqueId))
+    benchmarkConfig("button", HAButton deviceType(testUniqueId))
+    benchmarkConfig("camera", HACamera deviceType(testUniqueId))
+    benchmarkConfig("cover", HACover deviceType(testUniqueId))
+    benchmarkConfig("device_tracker", HADeviceTracker deviceType(testUniqueId))
+    benchmarkConfig(
+        "device_trigger",
+        HADeviceTrigger deviceType(
+            HADeviceTrigger::ButtonShortPressType,
+            HADeviceTrigger::TurnOnSubtype
+        )
+    )
+    benchmarkConfig("fan", HAFan deviceType(testUniqueId))
+    benchmarkConfig("hvac", HAHVAC deviceType(testUniqueId))
+    benchmarkConfig("light", HALight deviceType(testUniqueId))
+    benchmarkConfig("lock", HALock deviceType(testUniqueId))
+    benchmarkConfig("number", HANumber deviceType(testUniqueId))
+    benchmarkConfig("scene", HAScene deviceType(testUniqueId))
+    benchmarkConfig(
+        "select",
+        HASelect deviceType(testUniqueId); deviceType.setOptions("Option A;B;C")
+    )
+    benchmarkConfig("sensor", HASensor deviceType(testUniqueId))
+    benchmarkConfig("sensor_number", HASensorNumber deviceType(testUniqueId))
+    benchmarkConfig("switch", HASwitch deviceType(testUniqueId))
+    benchmarkConfig("tag_scanner", HATagScanner deviceType(testUniqueId))
+
+    finishBenchmark();
+}
+
+void loop()
+{
+
+}
@@ -0,0 +1,82 @@
+#include <ArduinoHA.h>
+#include "../BenchmarkUtils.h"
+
+#define BENCHMARK_NAME F("selectCommand")
+#define ITERATIONS_NB 20000
+
+static const char* testDeviceId = "testDevice";
+static const char* commandTopic = "testData/testDevice/select/cmd_t";
+static const uint8_t optionsNbCases[] = {3, 16, 64, 100};
+
+// prevents the compiler from optimizing out the measured calls
+static volatile uint32_t sink = 0;
+
+static void onSelectCommand(int8_t index, HASelect* sender)
+{
+    (void)sender;
+    sink += index;
+}
+
+static uint32_t measureCommand(HAMqtt& mqtt, const char* option)
+{
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>(option);
+    const uint16_t length = strlen(option);
+
+    return measureNsPerIteration(ITERATIONS_NB, [&]() {
+        mqtt.processMessage(commandTopic, payload, length);
+    });
+}
+
+static void runBenchmark(const uint8_t optionsNb)
+{
+    PubSubClientMock* mock = new PubSubClientMock();
+    HADevice device(testDeviceId);
+    HAMqtt mqtt(mock, device);
+    mqtt.setDataPrefix("testData");
+
+    // options have the same prefix, as in presets of the real devices
+    char* options = new char[optionsNb * 12];
+    options[0] = 0;
+
+    for (uint8_t i = 0; i < optionsNb; i++) {
+        sprintf(&options[strlen(options)], i == 0 ? "Preset %u" : ";Preset %u", i);
+    }
+
+    HASelect select("select");
+    select.onCommand(onSelectCommand);
+    select.setOptions(options);
+
+    char lastOption[16];
+    sprintf(lastOption, "Preset %u", optionsNb - 1);
+
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        optionsNb,
+        F("ns_per_last_option"),
+        measureCommand(mqtt, lastOption)
+    );
+    printBenchmarkResult(
+        BENCHMARK_NAME,
+        optionsNb,
+        F("ns_per_unknown_option"),
+        measureCommand(mqtt, "Preset X")
+    );
+
+    delete[] options;
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+    for (uint8_t i = 0; i < sizeof(optionsNbCases); i++) {
+        runBenchmark(optionsNbCases[i]);
+    }
+
+    finishBenchmark();
+}
+
+void loop()
+{
+
+}
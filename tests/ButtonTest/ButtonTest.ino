@@ -87,12 +87,22 @@ AHA_TEST(ButtonTest, command_subscription) {
     prepareTest
 
     HAButton button(testUniqueId);
+    button.onCommand(onCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
     assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
 }
 
+AHA_TEST(ButtonTest, command_subscription_without_callback) {
+    prepareTest
+
+    HAButton button(testUniqueId);
+    mqtt.loop();
+
+    assertEqual(0, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(ButtonTest, availability) {
     prepareTest
 
@@ -0,0 +1,166 @@
+#include <AUnit.h>
+#include <ArduinoHA.h>
+
+#define assertNumberToStr(number, expectedStr) \
+{ \
+    memset(tmpBuffer, 0, sizeof(tmpBuffer)); \
+    const uint16_t writtenLength = number.toStr(tmpBuffer); \
+    assertEqual(F(expectedStr), tmpBuffer); \
+    assertEqual((uint16_t)strlen(expectedStr), writtenLength); \
+    assertEqual((uint8_t)writtenLength, number.calculateSize()); \
+}
+
+#define assertDecimalStrToNumber(expected, precision, str) \
+{ \
+    HANumeric number = HANumeric::fromStr( \
+        reinterpret_cast<const uint8_t*>(str), \
+        strlen(str), \
+        precision \
+    ); \
+    assertTrue(number.isSet()); \
+    assertEqual((int64_t)expected, number.getBaseValue()); \
+    assertEqual((uint8_t)precision, number.getPrecision()); \
+}
+
+#define assertDecimalStrToNumberInvalid(precision, str) \
+{ \
+    HANumeric number = HANumeric::fromStr( \
+        reinterpret_cast<const uint8_t*>(str), \
+        strlen(str), \
+        precision \
+    ); \
+    assertFalse(number.isSet()); \
+}
+
+using aunit::TestRunner;
+
+char tmpBuffer[32];
+
+AHA_TEST(CompactNumericTest, size) {
+    assertEqual((size_t)4, sizeof(HANumeric));
+}
+
+AHA_TEST(CompactNumericTest, default_number) {
+    HANumeric number;
+
+    assertFalse(number.isSet());
+    assertEqual((int64_t)0, number.getBaseValue());
+    assertEqual((uint8_t)0, number.getPrecision());
+    assertEqual((uint8_t)0, number.calculateSize());
+}
+
+AHA_TEST(CompactNumericTest, constructors) {
+    HANumeric number((int16_t)-1234, 2);
+
+    assertTrue(number.isSet());
+    assertEqual((int64_t)-123400, number.getBaseValue());
+    assertEqual((uint8_t)2, number.getPrecision());
+    assertNumberToStr(number, "-1234.00")
+    assertNear(HANumeric(123.456f, 3).toFloat(), 123.456, 0.0001);
+}
+
+AHA_TEST(CompactNumericTest, limits) {
+    HANumeric max;
+    max.setBaseValue(HANumeric::MaxBaseValue);
+    max.setPrecision(3);
+
+    assertTrue(max.isSet());
+    assertEqual((int64_t)HANumeric::MaxBaseValue, max.getBaseValue());
+    assertNumberToStr(max, "536870.911")
+
+    HANumeric min;
+    min.setBaseValue(-HANumeric::MaxBaseValue);
+
+    assertTrue(min.isSet());
+    assertEqual((int64_t)-HANumeric::MaxBaseValue, min.getBaseValue());
+    assertNumberToStr(min, "-536870911")
+}
+
+AHA_TEST(CompactNumericTest, out_of_range) {
+    HANumeric number((int32_t)1, 0);
+    number.setBaseValue((int64_t)HANumeric::MaxBaseValue + 1);
+    assertFalse(number.isSet());
+
+    number.setBaseValue((int64_t)-HANumeric::MaxBaseValue - 1);
+    assertFalse(number.isSet());
+
+    assertFalse(HANumeric((uint32_t)4000000000UL, 0).isSet());
+    assertFalse(HANumeric((uint8_t)1, 4).isSet());
+}
+
+AHA_TEST(CompactNumericTest, precision_setter) {
+    HANumeric number;
+    number.setPrecision(2);
+
+    assertFalse(number.isSet());
+    assertEqual((uint8_t)2, number.getPrecision());
+
+    number.setBaseValue(-5);
+    assertTrue(number.isSet());
+    assertEqual((int64_t)-5, number.getBaseValue());
+    assertEqual((uint8_t)2, number.getPrecision());
+    assertNumberToStr(number, "-0.05")
+
+    number.setPrecision(1);
+    assertEqual((int64_t)-5, number.getBaseValue());
+    assertNumberToStr(number, "-0.5")
+
+    number.setPrecision(HANumeric::MaxPrecision + 1);
+    assertFalse(number.isSet());
+}
+
+AHA_TEST(CompactNumericTest, reset) {
+    HANumeric number((int8_t)-12, 1);
+    number.reset();
+
+    assertFalse(number.isSet());
+    assertEqual((int64_t)0, number.getBaseValue());
+    assertEqual((uint8_t)0, number.getPrecision());
+}
+
+AHA_TEST(CompactNumericTest, assignment_and_comparison) {
+    HANumeric number;
+    number = HANumeric((int32_t)-21, 1);
+
+    assertTrue(number == HANumeric((int32_t)-21, 1));
+    assertFalse(number == HANumeric((int32_t)-21, 2));
+    assertTrue(HANumeric() == HANumeric());
+
+    number = HANumeric();
+    assertFalse(number.isSet());
+}
+
+AHA_TEST(CompactNumericTest, type_checks) {
+    assertTrue(HANumeric((uint8_t)255, 0).isUInt8());
+    assertTrue(HANumeric((int16_t)-300, 0).isInt16());
+    assertFalse(HANumeric((int16_t)-300, 0).isUInt16());
+    assertTrue(HANumeric((int8_t)1, 1).isFloat());
+    assertFalse(HANumeric().isInt32());
+}
+
+AHA_TEST(CompactNumericTest, decimal_str_to_number) {
+    assertDecimalStrToNumber(215, 1, "21.5")
+    assertDecimalStrToNumber(-123457, 3, "-123.457")
+    assertDecimalStrToNumber(536870911, 0, "536870911")
+    assertDecimalStrToNumber(-536870911, 0, "-536870911")
+}
+
+AHA_TEST(CompactNumericTest, decimal_str_to_number_out_of_range) {
+    assertDecimalStrToNumberInvalid(0, "536870912")
+    assertDecimalStrToNumberInvalid(0, "-536870912")
+    assertDecimalStrToNumberInvalid(3, "536871")
+    assertDecimalStrToNumberInvalid(4, "1.5")
+}
+
+void setup()
+{
+    delay(1000);
+    Serial.begin(115200);
+    while (!Serial);
+}
+
+void loop()
+{
+    TestRunner::run();
+    delay(1);
+}
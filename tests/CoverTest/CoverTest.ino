@@ -116,12 +116,22 @@ AHA_TEST(CoverTest, command_subscription) {
     prepareTest
 
     HACover cover(testUniqueId);
+    cover.onCommand(onCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
     assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
 }
 
+AHA_TEST(CoverTest, command_subscription_without_callback) {
+    prepareTest
+
+    HACover cover(testUniqueId);
+    mqtt.loop();
+
+    assertEqual(0, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(CoverTest, availability) {
     prepareTest
 
@@ -477,6 +487,16 @@ AHA_TEST(CoverTest, command_invalid) {
     assertCommandCallbackNotCalled()
 }
 
+AHA_TEST(CoverTest, command_prefix) {
+    prepareTest
+
+    HACover cover(testUniqueId);
+    cover.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("OP"));
+
+    assertCommandCallbackNotCalled()
+}
+
 AHA_TEST(CoverTest, different_cover_command) {
     prepareTest
 
@@ -17,7 +17,7 @@ const char AvailabilityTopic[] PROGMEM = {"testData/testDevice/avty_t"};
 #define assertSerializerEntry(entry, eType, eSubtype, eProperty, eValue) \
     assertEqual(eType, entry->type); \
     assertEqual(eSubtype, entry->subtype); \
-    assertEqual(eProperty, entry->property); \
+    assertEqual(eProperty, entry->getProperty()); \
     assertEqual(eValue, entry->value);
 
 #define flushSerializer(mock, serializer) \
@@ -26,6 +26,12 @@ const char AvailabilityTopic[] PROGMEM = {"testData/testDevice/avty_t"};
     serializer->flush(); \
     mock->endPublish();
 
+#define flushDeviceData(mock, device) \
+    mock->connectDummy(); \
+    mock->beginPublish(dummyTopic, device.calculateSerializedSize(), false); \
+    device.flushSerializedData(); \
+    mock->endPublish();
+
 #define assertSerializerMqttMessage(expectedJson) \
     assertSingleMqttMessage(dummyTopic, expectedJson, false)
 
@@ -319,6 +325,60 @@ AHA_TEST(DeviceTest, full_serialization) {
     )
 }
 
+AHA_TEST(DeviceTest, serialized_size_cache) {
+    initMqttTest("myDeviceId");
+
+    device.setName("myName");
+    assertEqual((uint16_t)36, device.calculateSerializedSize());
+
+    device.setName("myLongerName");
+    assertEqual((uint16_t)42, device.calculateSerializedSize());
+
+    flushDeviceData(mock, device)
+    assertSerializerMqttMessage("{\"ids\":\"myDeviceId\",\"name\":\"myLongerName\"}")
+}
+
+AHA_TEST(DeviceTest, serialized_data_cache) {
+    initMqttTest("myDeviceId");
+
+    device.enableSerializerCache();
+    device.setName("myName");
+
+    flushDeviceData(mock, device)
+    assertSerializerMqttMessage("{\"ids\":\"myDeviceId\",\"name\":\"myName\"}")
+
+    mock->clearFlushedMessages();
+    flushDeviceData(mock, device)
+    assertSerializerMqttMessage("{\"ids\":\"myDeviceId\",\"name\":\"myName\"}")
+
+    mock->clearFlushedMessages();
+    device.setSoftwareVersion("1.0");
+    flushDeviceData(mock, device)
+    assertSerializerMqttMessage("{\"ids\":\"myDeviceId\",\"name\":\"myName\",\"sw\":\"1.0\"}")
+}
+
+AHA_TEST(DeviceTest, serialized_data_cache_in_entity) {
+    initMqttTest("myDeviceId");
+
+    device.enableSerializerCache();
+    device.setName("myName");
+    HASensor sensor("uniqueSensor");
+    mqtt.loop();
+
+    assertMqttMessage(
+        0,
+        "homeassistant/sensor/myDeviceId/uniqueSensor/config",
+        (
+            "{"
+            "\"uniq_id\":\"uniqueSensor\","
+            "\"dev\":{\"ids\":\"myDeviceId\",\"name\":\"myName\"},"
+            "\"stat_t\":\"testData/myDeviceId/uniqueSensor/stat_t\""
+            "}"
+        ),
+        true
+    )
+}
+
 void setup()
 {
     delay(1000);
@@ -147,6 +147,7 @@ AHA_TEST(FanTest, state_command_subscription) {
     prepareTest
 
     HAFan fan(testUniqueId);
+    fan.onStateCommand(onStateCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
@@ -160,6 +161,8 @@ AHA_TEST(FanTest, speed_command_subscription) {
     prepareTest
 
     HAFan fan(testUniqueId, HAFan::SpeedsFeature);
+    fan.onStateCommand(onStateCommandReceived);
+    fan.onSpeedCommand(onSpeedCommandReceived);
     mqtt.loop();
 
     assertEqual(2, mock->getSubscriptionsNb());
@@ -169,6 +172,15 @@ AHA_TEST(FanTest, speed_command_subscription) {
     );
 }
 
+AHA_TEST(FanTest, command_subscription_without_callback) {
+    prepareTest
+
+    HAFan fan(testUniqueId, HAFan::SpeedsFeature);
+    mqtt.loop();
+
+    assertEqual(0, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(FanTest, availability) {
     prepareTest
 
@@ -502,7 +514,7 @@ AHA_TEST(FanTest, state_command_different_fan) {
 AHA_TEST(FanTest, speed_command_half) {
     prepareTest
 
-    HAFan fan(testUniqueId);
+    HAFan fan(testUniqueId, HAFan::SpeedsFeature);
     fan.onSpeedCommand(onSpeedCommandReceived);
     mock->fakeMessage(AHATOFSTR(SpeedPercentageCommandTopic), F("50"));
 
@@ -512,7 +524,7 @@ AHA_TEST(FanTest, speed_command_half) {
 AHA_TEST(FanTest, speed_command_max) {
     prepareTest
 
-    HAFan fan(testUniqueId);
+    HAFan fan(testUniqueId, HAFan::SpeedsFeature);
     fan.onSpeedCommand(onSpeedCommandReceived);
     mock->fakeMessage(AHATOFSTR(SpeedPercentageCommandTopic), F("100"));
 
@@ -522,7 +534,7 @@ AHA_TEST(FanTest, speed_command_max) {
 AHA_TEST(FanTest, speed_command_in_range) {
     prepareTest
 
-    HAFan fan(testUniqueId);
+    HAFan fan(testUniqueId, HAFan::SpeedsFeature);
     fan.onSpeedCommand(onSpeedCommandReceived);
     fan.setSpeedRangeMin(1000);
     fan.setSpeedRangeMax(50000);
@@ -534,18 +546,28 @@ AHA_TEST(FanTest, speed_command_in_range) {
 AHA_TEST(FanTest, speed_command_invalid) {
     prepareTest
 
-    HAFan fan(testUniqueId);
+    HAFan fan(testUniqueId, HAFan::SpeedsFeature);
     fan.onSpeedCommand(onSpeedCommandReceived);
     mock->fakeMessage(AHATOFSTR(SpeedPercentageCommandTopic), F("INVALID"));
 
     assertSpeedCallbackNotCalled()
 }
 
-AHA_TEST(FanTest, speed_command_different_fan) {
+AHA_TEST(FanTest, speed_command_feature_disabled) {
     prepareTest
 
     HAFan fan(testUniqueId);
     fan.onSpeedCommand(onSpeedCommandReceived);
+    mock->fakeMessage(AHATOFSTR(SpeedPercentageCommandTopic), F("50"));
+
+    assertSpeedCallbackNotCalled()
+}
+
+AHA_TEST(FanTest, speed_command_different_fan) {
+    prepareTest
+
+    HAFan fan(testUniqueId, HAFan::SpeedsFeature);
+    fan.onSpeedCommand(onSpeedCommandReceived);
     mock->fakeMessage(
         F("testData/testDevice/uniqueFanDifferent/pct_cmd_t"),
         F("50")
@@ -375,7 +375,6 @@ AHA_TEST(HVACTest, config_with_target_temperature_p1) {
             "\"uniq_id\":\"uniqueHVAC\","
             "\"temp_cmd_t\":\"testData/testDevice/uniqueHVAC/temp_cmd_t\","
             "\"temp_stat_t\":\"testData/testDevice/uniqueHVAC/temp_stat_t\","
-            "\"temp_cmd_tpl\":\"{{int(float(value)*10**1)}}\","
             "\"curr_temp_t\":\"testData/testDevice/uniqueHVAC/curr_temp_t\","
             "\"dev\":{\"ids\":\"testDevice\"}"
             "}"
@@ -400,7 +399,6 @@ AHA_TEST(HVACTest, config_with_target_temperature_p2) {
             "\"uniq_id\":\"uniqueHVAC\","
             "\"temp_cmd_t\":\"testData/testDevice/uniqueHVAC/temp_cmd_t\","
             "\"temp_stat_t\":\"testData/testDevice/uniqueHVAC/temp_stat_t\","
-            "\"temp_cmd_tpl\":\"{{int(float(value)*10**2)}}\","
             "\"curr_temp_t\":\"testData/testDevice/uniqueHVAC/curr_temp_t\","
             "\"dev\":{\"ids\":\"testDevice\"}"
             "}"
@@ -425,7 +423,6 @@ AHA_TEST(HVACTest, config_with_target_temperature_p3) {
             "\"uniq_id\":\"uniqueHVAC\","
             "\"temp_cmd_t\":\"testData/testDevice/uniqueHVAC/temp_cmd_t\","
             "\"temp_stat_t\":\"testData/testDevice/uniqueHVAC/temp_stat_t\","
-            "\"temp_cmd_tpl\":\"{{int(float(value)*10**3)}}\","
             "\"curr_temp_t\":\"testData/testDevice/uniqueHVAC/curr_temp_t\","
             "\"dev\":{\"ids\":\"testDevice\"}"
             "}"
@@ -438,6 +435,7 @@ AHA_TEST(HVACTest, aux_command_subscription) {
     prepareTest
 
     HAHVAC hvac(testUniqueId, HAHVAC::AuxHeatingFeature);
+    hvac.onAuxStateCommand(onAuxStateCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
@@ -451,6 +449,7 @@ AHA_TEST(HVACTest, power_command_subscription) {
     prepareTest
 
     HAHVAC hvac(testUniqueId, HAHVAC::PowerFeature);
+    hvac.onPowerCommand(onPowerCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
@@ -464,6 +463,7 @@ AHA_TEST(HVACTest, fan_mode_command_subscription) {
     prepareTest
 
     HAHVAC hvac(testUniqueId, HAHVAC::FanFeature);
+    hvac.onFanModeCommand(onFanModeCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
@@ -477,6 +477,7 @@ AHA_TEST(HVACTest, swing_mode_command_subscription) {
     prepareTest
 
     HAHVAC hvac(testUniqueId, HAHVAC::SwingFeature);
+    hvac.onSwingModeCommand(onSwingModeCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
@@ -490,6 +491,7 @@ AHA_TEST(HVACTest, mode_command_subscription) {
     prepareTest
 
     HAHVAC hvac(testUniqueId, HAHVAC::ModesFeature);
+    hvac.onModeCommand(onModeCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
@@ -503,6 +505,7 @@ AHA_TEST(HVACTest, target_temperature_command_subscription) {
     prepareTest
 
     HAHVAC hvac(testUniqueId, HAHVAC::TargetTemperatureFeature);
+    hvac.onTargetTemperatureCommand(onTargetTemperatureCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
@@ -512,6 +515,23 @@ AHA_TEST(HVACTest, target_temperature_command_subscription) {
     );
 }
 
+AHA_TEST(HVACTest, command_subscription_without_callback) {
+    prepareTest
+
+    HAHVAC hvac(
+        testUniqueId,
+        HAHVAC::AuxHeatingFeature | HAHVAC::PowerFeature | HAHVAC::ModesFeature
+    );
+    hvac.onPowerCommand(onPowerCommandReceived);
+    mqtt.loop();
+
+    assertEqual(1, mock->getSubscriptionsNb());
+    assertEqual(
+        AHATOFSTR(PowerCommandTopic),
+        mock->getSubscriptions()[0]->topic
+    );
+}
+
 AHA_TEST(HVACTest, availability) {
     prepareTest
 
@@ -1683,6 +1703,16 @@ AHA_TEST(HVACTest, fan_mode_command_invalid) {
     assertFanModeCallbackNotCalled()
 }
 
+AHA_TEST(HVACTest, fan_mode_command_prefix) {
+    prepareTest
+
+    HAHVAC hvac(testUniqueId, HAHVAC::FanFeature);
+    hvac.onFanModeCommand(onFanModeCommandReceived);
+    mock->fakeMessage(AHATOFSTR(FanModeCommandTopic), F("med"));
+
+    assertFanModeCallbackNotCalled()
+}
+
 AHA_TEST(HVACTest, fan_mode_command_different) {
     prepareTest
 
@@ -1726,6 +1756,16 @@ AHA_TEST(HVACTest, swing_mode_command_invalid) {
     assertSwingModeCallbackNotCalled()
 }
 
+AHA_TEST(HVACTest, swing_mode_command_prefix) {
+    prepareTest
+
+    HAHVAC hvac(testUniqueId, HAHVAC::SwingFeature);
+    hvac.onSwingModeCommand(onSwingModeCommandReceived);
+    mock->fakeMessage(AHATOFSTR(SwingModeCommandTopic), F("o"));
+
+    assertSwingModeCallbackNotCalled()
+}
+
 AHA_TEST(HVACTest, swing_mode_command_different) {
     prepareTest
 
@@ -1799,12 +1839,52 @@ AHA_TEST(HVACTest, mode_command_fan_only) {
     assertModeCallbackCalled(HAHVAC::FanOnlyMode, &hvac)
 }
 
+AHA_TEST(HVACTest, mode_command_feature_disabled) {
+    prepareTest
+
+    HAHVAC hvac(testUniqueId, HAHVAC::FanFeature);
+    hvac.onModeCommand(onModeCommandReceived);
+    mock->fakeMessage(AHATOFSTR(ModeCommandTopic), F("auto"));
+
+    assertModeCallbackNotCalled()
+}
+
+AHA_TEST(HVACTest, mode_command_prefix) {
+    prepareTest
+
+    HAHVAC hvac(testUniqueId, HAHVAC::ModesFeature);
+    hvac.onModeCommand(onModeCommandReceived);
+    mock->fakeMessage(AHATOFSTR(ModeCommandTopic), F("fan"));
+
+    assertModeCallbackNotCalled()
+}
+
+AHA_TEST(HVACTest, mode_command_longer) {
+    prepareTest
+
+    HAHVAC hvac(testUniqueId, HAHVAC::ModesFeature);
+    hvac.onModeCommand(onModeCommandReceived);
+    mock->fakeMessage(AHATOFSTR(ModeCommandTopic), F("heating"));
+
+    assertModeCallbackNotCalled()
+}
+
+AHA_TEST(HVACTest, mode_command_empty) {
+    prepareTest
+
+    HAHVAC hvac(testUniqueId, HAHVAC::ModesFeature);
+    hvac.onModeCommand(onModeCommandReceived);
+    mock->fakeMessage(AHATOFSTR(ModeCommandTopic), F(""));
+
+    assertModeCallbackNotCalled()
+}
+
 AHA_TEST(HVACTest, target_temperature_command_p1) {
     prepareTest
 
     HAHVAC hvac(testUniqueId, HAHVAC::TargetTemperatureFeature);
     hvac.onTargetTemperatureCommand(onTargetTemperatureCommandReceived);
-    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("215"));
+    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("21.5"));
 
     assertTargetTempCallbackCalled(HANumeric(21.5f, 1), &hvac)
 }
@@ -1818,7 +1898,7 @@ AHA_TEST(HVACTest, target_temperature_command_p2) {
         HAHVAC::PrecisionP2
     );
     hvac.onTargetTemperatureCommand(onTargetTemperatureCommandReceived);
-    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("215"));
+    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("2.15"));
 
     assertTargetTempCallbackCalled(HANumeric(2.15f, 2), &hvac)
 }
@@ -1832,17 +1912,37 @@ AHA_TEST(HVACTest, target_temperature_command_p3) {
         HAHVAC::PrecisionP3
     );
     hvac.onTargetTemperatureCommand(onTargetTemperatureCommandReceived);
-    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("215"));
+    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("0.215"));
 
     assertTargetTempCallbackCalled(HANumeric(0.215f, 3), &hvac)
 }
 
+AHA_TEST(HVACTest, target_temperature_command_integer) {
+    prepareTest
+
+    HAHVAC hvac(testUniqueId, HAHVAC::TargetTemperatureFeature);
+    hvac.onTargetTemperatureCommand(onTargetTemperatureCommandReceived);
+    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("21"));
+
+    assertTargetTempCallbackCalled(HANumeric(21.0f, 1), &hvac)
+}
+
+AHA_TEST(HVACTest, target_temperature_command_truncated) {
+    prepareTest
+
+    HAHVAC hvac(testUniqueId, HAHVAC::TargetTemperatureFeature);
+    hvac.onTargetTemperatureCommand(onTargetTemperatureCommandReceived);
+    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("21.59"));
+
+    assertTargetTempCallbackCalled(HANumeric(21.5f, 1), &hvac)
+}
+
 AHA_TEST(HVACTest, target_temperature_command_invalid) {
     prepareTest
 
     HAHVAC hvac(testUniqueId, HAHVAC::TargetTemperatureFeature);
     hvac.onTargetTemperatureCommand(onTargetTemperatureCommandReceived);
-    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("21.5"));
+    mock->fakeMessage(AHATOFSTR(TemperatureCommandTopic), F("21.5a"));
 
     assertTargetTempCallbackNotCalled()
 }
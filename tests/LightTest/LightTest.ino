@@ -282,6 +282,7 @@ AHA_TEST(LightTest, state_command_subscription) {
     prepareTest
 
     HALight light(testUniqueId);
+    light.onStateCommand(onStateCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
@@ -295,6 +296,8 @@ AHA_TEST(LightTest, brightness_command_subscription) {
     prepareTest
 
     HALight light(testUniqueId, HALight::BrightnessFeature);
+    light.onStateCommand(onStateCommandReceived);
+    light.onBrightnessCommand(onBrightnessCommandReceived);
     mqtt.loop();
 
     assertEqual(2, mock->getSubscriptionsNb());
@@ -308,6 +311,8 @@ AHA_TEST(LightTest, color_temperature_command_subscription) {
     prepareTest
 
     HALight light(testUniqueId, HALight::ColorTemperatureFeature);
+    light.onStateCommand(onStateCommandReceived);
+    light.onColorTemperatureCommand(onColorTemperatureCommandReceived);
     mqtt.loop();
 
     assertEqual(2, mock->getSubscriptionsNb());
@@ -321,6 +326,8 @@ AHA_TEST(LightTest, rgb_command_subscription) {
     prepareTest
 
     HALight light(testUniqueId, HALight::RGBFeature);
+    light.onStateCommand(onStateCommandReceived);
+    light.onRGBColorCommand(onRGBColorCommand);
     mqtt.loop();
 
     assertEqual(2, mock->getSubscriptionsNb());
@@ -330,6 +337,69 @@ AHA_TEST(LightTest, rgb_command_subscription) {
     );
 }
 
+AHA_TEST(LightTest, command_subscription_without_callback) {
+    prepareTest
+
+    HALight light(testUniqueId, HALight::BrightnessFeature | HALight::RGBFeature);
+    light.onBrightnessCommand(onBrightnessCommandReceived);
+    mqtt.loop();
+
+    assertEqual(1, mock->getSubscriptionsNb());
+    assertEqual(
+        AHATOFSTR(BrightnessCommandTopic),
+        mock->getSubscriptions()[0]->topic
+    );
+}
+
+AHA_TEST(LightTest, command_subscription_runtime) {
+    prepareTest
+
+    HALight light(testUniqueId, HALight::BrightnessFeature);
+    mqtt.loop();
+    assertEqual(0, mock->getSubscriptionsNb());
+
+    light.onStateCommand(onStateCommandReceived);
+    assertEqual(1, mock->getSubscriptionsNb());
+    assertEqual(
+        AHATOFSTR(StateCommandTopic),
+        mock->getSubscriptions()[0]->topic
+    );
+}
+
+AHA_TEST(LightTest, command_subscription_runtime_single_topic) {
+    prepareTest
+
+    HALight light(testUniqueId, HALight::BrightnessFeature);
+    light.onStateCommand(onStateCommandReceived);
+    mqtt.loop();
+    assertEqual(1, mock->getSubscriptionsNb());
+
+    // only the topic of the new callback is subscribed
+    light.onBrightnessCommand(onBrightnessCommandReceived);
+    light.onStateCommand(onStateCommandReceived);
+    assertEqual(2, mock->getSubscriptionsNb());
+    assertEqual(
+        AHATOFSTR(BrightnessCommandTopic),
+        mock->getSubscriptions()[1]->topic
+    );
+}
+
+AHA_TEST(LightTest, command_subscription_reconnect) {
+    prepareTest
+
+    HALight light(testUniqueId, HALight::BrightnessFeature);
+    light.onStateCommand(onStateCommandReceived);
+    light.onBrightnessCommand(onBrightnessCommandReceived);
+    mqtt.loop();
+    assertEqual(2, mock->getSubscriptionsNb());
+
+    mock->clearSubscriptions();
+    mqtt.disconnect();
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+    assertEqual(2, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(LightTest, availability) {
     prepareTest
 
@@ -824,7 +894,7 @@ AHA_TEST(LightTest, state_command_different_light) {
 AHA_TEST(LightTest, brightness_command_min) {
     prepareTest
 
-    HALight light(testUniqueId);
+    HALight light(testUniqueId, HALight::BrightnessFeature);
     light.onBrightnessCommand(onBrightnessCommandReceived);
     mock->fakeMessage(AHATOFSTR(BrightnessCommandTopic), F("0"));
 
@@ -834,7 +904,7 @@ AHA_TEST(LightTest, brightness_command_min) {
 AHA_TEST(LightTest, brightness_command_max) {
     prepareTest
 
-    HALight light(testUniqueId);
+    HALight light(testUniqueId, HALight::BrightnessFeature);
     light.onBrightnessCommand(onBrightnessCommandReceived);
     mock->fakeMessage(AHATOFSTR(BrightnessCommandTopic), F("255"));
 
@@ -844,7 +914,7 @@ AHA_TEST(LightTest, brightness_command_max) {
 AHA_TEST(LightTest, brightness_command_overflow) {
     prepareTest
 
-    HALight light(testUniqueId);
+    HALight light(testUniqueId, HALight::BrightnessFeature);
     light.onBrightnessCommand(onBrightnessCommandReceived);
     mock->fakeMessage(AHATOFSTR(BrightnessCommandTopic), F("300"));
 
@@ -854,7 +924,7 @@ AHA_TEST(LightTest, brightness_command_overflow) {
 AHA_TEST(LightTest, brightness_command_invalid) {
     prepareTest
 
-    HALight light(testUniqueId);
+    HALight light(testUniqueId, HALight::BrightnessFeature);
     light.onBrightnessCommand(onBrightnessCommandReceived);
     mock->fakeMessage(AHATOFSTR(BrightnessCommandTopic), F("INVALID"));
 
@@ -864,7 +934,7 @@ AHA_TEST(LightTest, brightness_command_invalid) {
 AHA_TEST(LightTest, brightness_command_different_light) {
     prepareTest
 
-    HALight light(testUniqueId);
+    HALight light(testUniqueId, HALight::BrightnessFeature);
     light.onBrightnessCommand(onBrightnessCommandReceived);
     mock->fakeMessage(
         F("testData/testDevice/uniqueLightDifferent/pct_cmd_t"),
@@ -874,6 +944,16 @@ AHA_TEST(LightTest, brightness_command_different_light) {
     assertBrightnessCallbackNotCalled()
 }
 
+AHA_TEST(LightTest, brightness_command_feature_disabled) {
+    prepareTest
+
+    HALight light(testUniqueId);
+    light.onBrightnessCommand(onBrightnessCommandReceived);
+    mock->fakeMessage(AHATOFSTR(BrightnessCommandTopic), F("50"));
+
+    assertBrightnessCallbackNotCalled()
+}
+
 AHA_TEST(LightTest, color_temperature_command) {
     prepareTest
 
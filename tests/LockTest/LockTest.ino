@@ -95,12 +95,22 @@ AHA_TEST(LockTest, command_subscription) {
     prepareTest
 
     HALock lock(testUniqueId);
+    lock.onCommand(onCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
     assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
 }
 
+AHA_TEST(LockTest, command_subscription_without_callback) {
+    prepareTest
+
+    HALock lock(testUniqueId);
+    mqtt.loop();
+
+    assertEqual(0, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(LockTest, availability) {
     prepareTest
 
@@ -314,6 +324,16 @@ AHA_TEST(LockTest, command_invalid) {
     assertCommandCallbackNotCalled()
 }
 
+AHA_TEST(LockTest, command_prefix) {
+    prepareTest
+
+    HALock lock(testUniqueId);
+    lock.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("UN"));
+
+    assertCommandCallbackNotCalled()
+}
+
 AHA_TEST(LockTest, different_lock_command) {
     prepareTest
 
@@ -8,16 +8,85 @@ static const char* testUniqueId = "uniqueId";
 
 const char ComponentNameStr[] PROGMEM = {"componentName"};
 
+static uint8_t lastProcessedNb = 0;
+static uint8_t progressCallsNb = 0;
+static uint32_t storedConfigHash = 0;
+static uint8_t savedConfigHashesNb = 0;
+static uint8_t switchCommandsNb = 0;
+
+#define assertComponentPlatform(config, platform) \
+    assertTrue(strstr(config, "{\"p\":\"" platform "\"") != nullptr);
+
+#define reconnectMqttTest() \
+    mock->clearFlushedMessages(); \
+    mock->clearSubscriptions(); \
+    mqtt.disconnect(); \
+    mqtt.begin("testHost", "testUser", "testPass"); \
+    mqtt.loop();
+
+void onConnectProgress(uint8_t processedNb, uint8_t totalNb)
+{
+    (void)totalNb;
+    lastProcessedNb = processedNb;
+    progressCallsNb++;
+}
+
+uint32_t loadConfigHash(const char* uniqueId)
+{
+    (void)uniqueId;
+    return storedConfigHash;
+}
+
+void saveConfigHash(const char* uniqueId, uint32_t hash)
+{
+    (void)uniqueId;
+    storedConfigHash = hash;
+    savedConfigHashesNb++;
+}
+
+void onSwitchCommand(bool state, HASwitch* sender)
+{
+    (void)state;
+    (void)sender;
+    switchCommandsNb++;
+}
+
+void onLightStateCommand(bool state, HALight* sender)
+{
+    (void)state;
+    (void)sender;
+}
+
+void onLightBrightnessCommand(uint8_t brightness, HALight* sender)
+{
+    (void)brightness;
+    (void)sender;
+}
+
 class DummyDeviceType : public HABaseDeviceType
 {
 public:
     DummyDeviceType(const __FlashStringHelper* componentName, const char* uniqueId) :
-        HABaseDeviceType(componentName, uniqueId) { }
+        HABaseDeviceType(componentName, uniqueId), messagesNb(0) { }
+
+    uint8_t messagesNb;
 
 protected:
     virtual void onMqttConnected() override {
         publishAvailability();
     }
+
+    virtual void onMqttMessage(
+        const char* topic,
+        const uint8_t* payload,
+        const uint16_t length
+    ) override {
+        (void)topic;
+        (void)payload;
+        (void)length;
+
+        messagesNb++;
+    }
 };
 
 AHA_TEST(MqttTest, maximum_number_of_device_types) {
@@ -29,6 +98,521 @@ AHA_TEST(MqttTest, maximum_number_of_device_types) {
     assertEqual(&deviceType, mqtt.getDevicesTypes()[0]);
 }
 
+AHA_TEST(MqttTest, route_message_to_owner) {
+    initMqttTest(testDeviceId)
+
+    DummyDeviceType typeC(AHATOFSTR(ComponentNameStr), "c");
+    DummyDeviceType typeA(AHATOFSTR(ComponentNameStr), "a");
+    DummyDeviceType typeAB(AHATOFSTR(ComponentNameStr), "ab");
+    DummyDeviceType typeB(AHATOFSTR(ComponentNameStr), "b");
+
+    mock->fakeMessage("testData/testDevice/ab/cmd_t", "ON");
+    mock->fakeMessage("testData/testDevice/c/cmd_t", "ON");
+    mock->fakeMessage("testData/testDevice/c/cmd_t", "ON");
+
+    assertEqual((uint8_t)0, typeA.messagesNb);
+    assertEqual((uint8_t)1, typeAB.messagesNb);
+    assertEqual((uint8_t)0, typeB.messagesNb);
+    assertEqual((uint8_t)2, typeC.messagesNb);
+}
+
+AHA_TEST(MqttTest, route_message_late_unique_id) {
+    initMqttTest(testDeviceId)
+
+    DummyDeviceType typeA(AHATOFSTR(ComponentNameStr), "a");
+    HADeviceTrigger trigger(HADeviceTrigger::ButtonShortPressType, HADeviceTrigger::Button1Subtype);
+    DummyDeviceType typeB(AHATOFSTR(ComponentNameStr), "b");
+    DummyDeviceType typeC(AHATOFSTR(ComponentNameStr), "c");
+
+    mock->fakeMessage("testData/testDevice/a/cmd_t", "ON");
+    mock->fakeMessage("testData/testDevice/b/cmd_t", "ON");
+    mock->fakeMessage("testData/testDevice/c/cmd_t", "ON");
+
+    assertEqual((uint8_t)1, typeA.messagesNb);
+    assertEqual((uint8_t)1, typeB.messagesNb);
+    assertEqual((uint8_t)1, typeC.messagesNb);
+}
+
+AHA_TEST(MqttTest, route_message_unknown_owner) {
+    initMqttTest(testDeviceId)
+
+    DummyDeviceType typeA(AHATOFSTR(ComponentNameStr), "a");
+    DummyDeviceType typeB(AHATOFSTR(ComponentNameStr), "b");
+
+    mock->fakeMessage("testData/testDevice/x/cmd_t", "ON");
+    mock->fakeMessage("testData/testDevice/a_/cmd_t", "ON");
+
+    assertEqual((uint8_t)0, typeA.messagesNb);
+    assertEqual((uint8_t)0, typeB.messagesNb);
+}
+
+AHA_TEST(MqttTest, broadcast_foreign_message) {
+    initMqttTest(testDeviceId)
+
+    DummyDeviceType typeA(AHATOFSTR(ComponentNameStr), "a");
+    DummyDeviceType typeB(AHATOFSTR(ComponentNameStr), "b");
+
+    mock->fakeMessage("homeassistant/status", "online");
+
+    assertEqual((uint8_t)1, typeA.messagesNb);
+    assertEqual((uint8_t)1, typeB.messagesNb);
+}
+
+AHA_TEST(MqttTest, config_cache_skip_unchanged) {
+    initMqttTest(testDeviceId)
+    mqtt.enableConfigCache();
+
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+    assertEqual(1, mock->getFlushedMessagesNb());
+
+    reconnectMqttTest()
+    assertNoMqttMessage()
+}
+
+AHA_TEST(MqttTest, config_cache_changed_config) {
+    initMqttTest(testDeviceId)
+    mqtt.enableConfigCache();
+
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    sensor.setName("Changed");
+    reconnectMqttTest()
+    assertSingleMqttMessage(
+        "homeassistant/sensor/testDevice/uniqueId/config",
+        "{\"name\":\"Changed\",\"uniq_id\":\"uniqueId\",\"dev\":{\"ids\":\"testDevice\"},\"stat_t\":\"testData/testDevice/uniqueId/stat_t\"}",
+        true
+    )
+}
+
+AHA_TEST(MqttTest, config_cache_disabled) {
+    initMqttTest(testDeviceId)
+
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    reconnectMqttTest()
+    assertEqual(1, mock->getFlushedMessagesNb());
+    assertEqual((uint8_t)0, mock->getSubscriptionsNb());
+}
+
+AHA_TEST(MqttTest, config_cache_storage) {
+    storedConfigHash = 0;
+    savedConfigHashesNb = 0;
+
+    {
+        initMqttTest(testDeviceId)
+        mqtt.enableConfigCache();
+        mqtt.onConfigHashLoad(loadConfigHash);
+        mqtt.onConfigHashSave(saveConfigHash);
+
+        HASensor sensor(testUniqueId);
+        mqtt.loop();
+        assertEqual(1, mock->getFlushedMessagesNb());
+
+        reconnectMqttTest()
+        assertNoMqttMessage()
+        assertEqual((uint8_t)1, savedConfigHashesNb);
+    }
+
+    // reboot
+    {
+        initMqttTest(testDeviceId)
+        mqtt.enableConfigCache();
+        mqtt.onConfigHashLoad(loadConfigHash);
+        mqtt.onConfigHashSave(saveConfigHash);
+
+        HASensor sensor(testUniqueId);
+        mqtt.loop();
+        assertNoMqttMessage()
+        assertEqual((uint8_t)1, savedConfigHashesNb);
+    }
+}
+
+AHA_TEST(MqttTest, config_cache_birth_message) {
+    initMqttTest(testDeviceId)
+    mqtt.enableConfigCache();
+
+    DummyDeviceType deviceType(AHATOFSTR(ComponentNameStr), "dummy");
+    HASensor sensor(testUniqueId);
+    mqtt.loop();
+
+    assertEqual((uint8_t)1, mock->getSubscriptionsNb());
+    assertEqual("homeassistant/status", mock->getSubscriptions()[0]->topic);
+
+    mock->clearFlushedMessages();
+    mock->fakeMessage("homeassistant/status", "offline");
+    assertNoMqttMessage()
+
+    mock->fakeMessage("homeassistant/status", "online");
+    assertEqual(1, mock->getFlushedMessagesNb());
+    assertEqual((uint8_t)1, deviceType.messagesNb); // only the "offline" message
+
+    reconnectMqttTest()
+    assertNoMqttMessage()
+}
+
+AHA_TEST(MqttTest, connect_phase_at_once) {
+    lastProcessedNb = 0;
+    progressCallsNb = 0;
+
+    initMqttTest(testDeviceId)
+    mqtt.onConnectProgress(onConnectProgress);
+
+    HASensor sensorA("a");
+    HASensor sensorB("b");
+    HASensor sensorC("c");
+    mqtt.loop();
+
+    assertEqual(3, mock->getFlushedMessagesNb());
+    assertEqual((uint8_t)3, lastProcessedNb);
+    assertEqual((uint8_t)3, progressCallsNb);
+    assertTrue(mqtt.isConnectPhaseFinished());
+}
+
+AHA_TEST(MqttTest, connect_phase_bytes_budget) {
+    lastProcessedNb = 0;
+    progressCallsNb = 0;
+
+    initMqttTest(testDeviceId)
+    mqtt.onConnectProgress(onConnectProgress);
+    mqtt.setConnectPacing(1);
+
+    HASensor sensorA("a");
+    HASensor sensorB("b");
+    HASensor sensorC("c");
+    mqtt.loop();
+    mock->setState(HAMqtt::StateConnected);
+
+    assertEqual(1, mock->getFlushedMessagesNb());
+    assertEqual((uint8_t)1, lastProcessedNb);
+    assertFalse(mqtt.isConnectPhaseFinished());
+
+    mqtt.loop();
+    assertEqual(2, mock->getFlushedMessagesNb());
+    assertEqual((uint8_t)2, lastProcessedNb);
+
+    mqtt.loop();
+    assertEqual(3, mock->getFlushedMessagesNb());
+    assertEqual((uint8_t)3, lastProcessedNb);
+    assertTrue(mqtt.isConnectPhaseFinished());
+
+    mqtt.loop();
+    assertEqual(3, mock->getFlushedMessagesNb());
+    assertEqual((uint8_t)3, progressCallsNb);
+}
+
+AHA_TEST(MqttTest, connect_phase_large_bytes_budget) {
+    initMqttTest(testDeviceId)
+    mqtt.setConnectPacing(1024);
+
+    HASensor sensorA("a");
+    HASensor sensorB("b");
+    HASensor sensorC("c");
+    mqtt.loop();
+
+    assertEqual(3, mock->getFlushedMessagesNb());
+    assertTrue(mqtt.isConnectPhaseFinished());
+}
+
+AHA_TEST(MqttTest, subscription_per_topic) {
+    initMqttTest(testDeviceId)
+
+    HALight light("light", HALight::BrightnessFeature);
+    light.onStateCommand(onLightStateCommand);
+    light.onBrightnessCommand(onLightBrightnessCommand);
+    HASwitch relay("relay");
+    relay.onCommand(onSwitchCommand);
+    mqtt.loop();
+
+    assertEqual((uint8_t)3, mock->getSubscriptionsNb());
+    assertEqual("testData/testDevice/light/cmd_t", mock->getSubscriptions()[0]->topic);
+    assertEqual("testData/testDevice/light/bri_cmd_t", mock->getSubscriptions()[1]->topic);
+    assertEqual("testData/testDevice/relay/cmd_t", mock->getSubscriptions()[2]->topic);
+}
+
+AHA_TEST(MqttTest, subscription_per_device_type) {
+    switchCommandsNb = 0;
+
+    initMqttTest(testDeviceId)
+    mqtt.setSubscriptionMode(HAMqtt::SubscriptionPerDeviceType);
+
+    HALight light("light", HALight::BrightnessFeature);
+    light.onStateCommand(onLightStateCommand);
+    light.onBrightnessCommand(onLightBrightnessCommand);
+    HASensor sensor("sensor");
+    HASwitch relay("relay");
+    relay.onCommand(onSwitchCommand);
+    mqtt.loop();
+
+    assertEqual((uint8_t)2, mock->getSubscriptionsNb());
+    assertEqual("testData/testDevice/light/+", mock->getSubscriptions()[0]->topic);
+    assertEqual("testData/testDevice/relay/+", mock->getSubscriptions()[1]->topic);
+
+    mock->fakeMessage("testData/testDevice/relay/stat_t", "ON");
+    assertEqual((uint8_t)0, switchCommandsNb);
+
+    mock->fakeMessage("testData/testDevice/relay/cmd_t", "ON");
+    assertEqual((uint8_t)1, switchCommandsNb);
+
+    reconnectMqttTest()
+    assertEqual((uint8_t)2, mock->getSubscriptionsNb());
+}
+
+AHA_TEST(MqttTest, subscription_per_device_type_runtime) {
+    initMqttTest(testDeviceId)
+    mqtt.setSubscriptionMode(HAMqtt::SubscriptionPerDeviceType);
+
+    HALight light("light", HALight::BrightnessFeature);
+    light.onStateCommand(onLightStateCommand);
+    HASwitch relay("relay");
+    relay.onCommand(onSwitchCommand);
+    mqtt.loop();
+    assertEqual((uint8_t)2, mock->getSubscriptionsNb());
+
+    // the light's wildcard topic already covers the brightness topic
+    light.onBrightnessCommand(onLightBrightnessCommand);
+    assertEqual((uint8_t)2, mock->getSubscriptionsNb());
+}
+
+AHA_TEST(MqttTest, subscription_per_device) {
+    switchCommandsNb = 0;
+
+    initMqttTest(testDeviceId)
+    mqtt.setSubscriptionMode(HAMqtt::SubscriptionPerDevice);
+
+    HALight light("light", HALight::BrightnessFeature);
+    light.onStateCommand(onLightStateCommand);
+    light.onBrightnessCommand(onLightBrightnessCommand);
+    HASwitch relay("relay");
+    relay.onCommand(onSwitchCommand);
+    mqtt.loop();
+
+    assertEqual((uint8_t)1, mock->getSubscriptionsNb());
+    assertEqual("testData/testDevice/+/+", mock->getSubscriptions()[0]->topic);
+
+    mock->fakeMessage("testData/testDevice/relay/stat_t", "ON");
+    mock->fakeMessage("testData/testDevice/light/cmd_t", "ON");
+    assertEqual((uint8_t)0, switchCommandsNb);
+
+    mock->fakeMessage("testData/testDevice/relay/cmd_t", "ON");
+    assertEqual((uint8_t)1, switchCommandsNb);
+
+    reconnectMqttTest()
+    assertEqual((uint8_t)1, mock->getSubscriptionsNb());
+}
+
+AHA_TEST(MqttTest, subscriptions_batching) {
+    initMqttTest(testDeviceId)
+    mqtt.enableConfigCache();
+    mqtt.enableSubscriptionsBatching();
+
+    HALight light("light", HALight::BrightnessFeature);
+    light.onStateCommand(onLightStateCommand);
+    light.onBrightnessCommand(onLightBrightnessCommand);
+    HASwitch relay("relay");
+    relay.onCommand(onSwitchCommand);
+    mqtt.loop();
+
+    assertEqual((uint8_t)1, mock->getSubscribePacketsNb());
+    assertEqual((uint8_t)0, mock->getMalformedPacketsNb());
+    assertEqual((uint16_t)0x8000, mock->getLastPacketId());
+    assertEqual((uint8_t)4, mock->getSubscriptionsNb());
+    assertEqual("homeassistant/status", mock->getSubscriptions()[0]->topic);
+    assertEqual("testData/testDevice/light/cmd_t", mock->getSubscriptions()[1]->topic);
+    assertEqual("testData/testDevice/light/bri_cmd_t", mock->getSubscriptions()[2]->topic);
+    assertEqual("testData/testDevice/relay/cmd_t", mock->getSubscriptions()[3]->topic);
+
+    reconnectMqttTest()
+    assertEqual((uint8_t)1, mock->getSubscribePacketsNb());
+    assertEqual((uint16_t)0x8001, mock->getLastPacketId());
+    assertEqual((uint8_t)4, mock->getSubscriptionsNb());
+}
+
+AHA_TEST(MqttTest, subscriptions_batching_full_buffer) {
+    initMqttTest(testDeviceId)
+    mqtt.enableSubscriptionsBatching(80);
+
+    HALight light("light", HALight::BrightnessFeature);
+    light.onStateCommand(onLightStateCommand);
+    light.onBrightnessCommand(onLightBrightnessCommand);
+    HASwitch relay("relay");
+    relay.onCommand(onSwitchCommand);
+    mqtt.loop();
+
+    assertEqual((uint8_t)2, mock->getSubscribePacketsNb());
+    assertEqual((uint8_t)0, mock->getMalformedPacketsNb());
+    assertEqual((uint8_t)3, mock->getSubscriptionsNb());
+    assertEqual("testData/testDevice/light/cmd_t", mock->getSubscriptions()[0]->topic);
+    assertEqual("testData/testDevice/light/bri_cmd_t", mock->getSubscriptions()[1]->topic);
+    assertEqual("testData/testDevice/relay/cmd_t", mock->getSubscriptions()[2]->topic);
+}
+
+AHA_TEST(MqttTest, subscriptions_batching_topic_too_long) {
+    initMqttTest(testDeviceId)
+    mqtt.enableSubscriptionsBatching(42);
+
+    HALight light("light", HALight::BrightnessFeature);
+    light.onStateCommand(onLightStateCommand);
+    light.onBrightnessCommand(onLightBrightnessCommand);
+    mqtt.loop();
+
+    // the brightness topic doesn't fit the buffer, so it's subscribed separately
+    assertEqual((uint8_t)2, mock->getSubscribePacketsNb());
+    assertEqual((uint8_t)0, mock->getMalformedPacketsNb());
+    assertEqual((uint8_t)2, mock->getSubscriptionsNb());
+    assertEqual("testData/testDevice/light/bri_cmd_t", mock->getSubscriptions()[0]->topic);
+    assertEqual("testData/testDevice/light/cmd_t", mock->getSubscriptions()[1]->topic);
+}
+
+AHA_TEST(MqttTest, subscriptions_batching_long_packet) {
+    initMqttTest(testDeviceId)
+    mqtt.enableSubscriptionsBatching();
+
+    HALight lightA("a", HALight::BrightnessFeature);
+    lightA.onStateCommand(onLightStateCommand);
+    lightA.onBrightnessCommand(onLightBrightnessCommand);
+    HALight lightB("b", HALight::BrightnessFeature);
+    lightB.onStateCommand(onLightStateCommand);
+    lightB.onBrightnessCommand(onLightBrightnessCommand);
+    HALight lightC("c", HALight::BrightnessFeature);
+    lightC.onStateCommand(onLightStateCommand);
+    lightC.onBrightnessCommand(onLightBrightnessCommand);
+    HALight lightD("d", HALight::BrightnessFeature);
+    lightD.onStateCommand(onLightStateCommand);
+    lightD.onBrightnessCommand(onLightBrightnessCommand);
+    mqtt.loop();
+
+    // the remaining length takes two bytes
+    assertEqual((uint8_t)1, mock->getSubscribePacketsNb());
+    assertEqual((uint8_t)0, mock->getMalformedPacketsNb());
+    assertEqual((uint8_t)8, mock->getSubscriptionsNb());
+    assertEqual("testData/testDevice/d/bri_cmd_t", mock->getSubscriptions()[7]->topic);
+}
+
+AHA_TEST(MqttTest, subscriptions_batching_with_pacing) {
+    initMqttTest(testDeviceId)
+    mqtt.enableSubscriptionsBatching();
+    mqtt.setConnectPacing(1);
+
+    HASwitch relayA("a");
+    relayA.onCommand(onSwitchCommand);
+    HASwitch relayB("b");
+    relayB.onCommand(onSwitchCommand);
+    mqtt.loop();
+
+    assertEqual((uint8_t)1, mock->getSubscribePacketsNb());
+    assertEqual((uint8_t)1, mock->getSubscriptionsNb());
+
+    mqtt.loop();
+    assertEqual((uint8_t)2, mock->getSubscribePacketsNb());
+    assertEqual((uint8_t)0, mock->getMalformedPacketsNb());
+    assertEqual("testData/testDevice/b/cmd_t", mock->getSubscriptions()[1]->topic);
+}
+
+AHA_TEST(MqttTest, device_discovery) {
+    initMqttTest(testDeviceId)
+    mqtt.enableDeviceDiscovery();
+
+    HASensor sensor("sensorA");
+    HASwitch testSwitch("switchA");
+    mqtt.loop();
+
+    assertMqttMessage(
+        0,
+        "homeassistant/device/testDevice/config",
+        (
+            "{"
+            "\"dev\":{\"ids\":\"testDevice\"},"
+            "\"o\":{\"name\":\"ArduinoHA\"},"
+            "\"cmps\":{"
+            "\"sensorA\":{"
+            "\"p\":\"sensor\","
+            "\"uniq_id\":\"sensorA\","
+            "\"stat_t\":\"testData/testDevice/sensorA/stat_t\""
+            "},"
+            "\"switchA\":{"
+            "\"p\":\"switch\","
+            "\"uniq_id\":\"switchA\","
+            "\"stat_t\":\"testData/testDevice/switchA/stat_t\","
+            "\"cmd_t\":\"testData/testDevice/switchA/cmd_t\""
+            "}"
+            "}"
+            "}"
+        ),
+        true
+    )
+
+    // the switch publishes its state
+    assertEqual(2, mock->getFlushedMessagesNb());
+}
+
+AHA_TEST(MqttTest, device_discovery_platforms) {
+    initMqttTest(testDeviceId)
+    mqtt.enableDeviceDiscovery();
+
+    HABinarySensor binarySensor("binarySensor");
+    HAButton button("button");
+    HACamera camera("camera");
+    HACover cover("cover");
+    HADeviceTracker tracker("tracker");
+    HADeviceTrigger trigger(HADeviceTrigger::ButtonShortPressType, HADeviceTrigger::Button1Subtype);
+    HAFan fan("fan");
+    HAHVAC hvac("hvac");
+    HALight light("light");
+    HALock lock("lock");
+    HANumber number("number");
+    HAScene scene("scene");
+    HASelect select("select");
+    select.setOptions("A;B");
+    HASensorNumber sensor("sensor");
+    HASwitch testSwitch("switch");
+    HATagScanner tagScanner("tagScanner");
+    mqtt.loop();
+
+    const MqttMessage* config = mock->getFlushedMessages()[0];
+    assertEqual("homeassistant/device/testDevice/config", config->topic);
+    assertEqual(strlen(config->buffer) + 1, config->bufferSize);
+
+    assertComponentPlatform(config->buffer, "binary_sensor")
+    assertComponentPlatform(config->buffer, "button")
+    assertComponentPlatform(config->buffer, "camera")
+    assertComponentPlatform(config->buffer, "cover")
+    assertComponentPlatform(config->buffer, "device_tracker")
+    assertComponentPlatform(config->buffer, "device_automation")
+    assertComponentPlatform(config->buffer, "fan")
+    assertComponentPlatform(config->buffer, "climate")
+    assertComponentPlatform(config->buffer, "light")
+    assertComponentPlatform(config->buffer, "lock")
+    assertComponentPlatform(config->buffer, "number")
+    assertComponentPlatform(config->buffer, "scene")
+    assertComponentPlatform(config->buffer, "select")
+    assertComponentPlatform(config->buffer, "sensor")
+    assertComponentPlatform(config->buffer, "switch")
+    assertComponentPlatform(config->buffer, "tag")
+}
+
+AHA_TEST(MqttTest, device_discovery_with_config_cache) {
+    initMqttTest(testDeviceId)
+    mqtt.enableDeviceDiscovery();
+    mqtt.enableConfigCache();
+
+    HASensor sensor("sensorA");
+    mqtt.loop();
+    assertEqual(1, mock->getFlushedMessagesNb());
+
+    reconnectMqttTest()
+    assertNoMqttMessage()
+
+    mock->fakeMessage("homeassistant/status", "online");
+    assertEqual(1, mock->getFlushedMessagesNb());
+    assertEqual(
+        "homeassistant/device/testDevice/config",
+        mock->getFlushedMessages()[0]->topic
+    );
+}
+
 void setup()
 {
     delay(1000);
@@ -95,12 +95,22 @@ AHA_TEST(NumberTest, command_subscription) {
     prepareTest
 
     HANumber number(testUniqueId);
+    number.onCommand(onCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
     assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
 }
 
+AHA_TEST(NumberTest, command_subscription_without_callback) {
+    prepareTest
+
+    HANumber number(testUniqueId);
+    mqtt.loop();
+
+    assertEqual(0, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(NumberTest, availability) {
     prepareTest
 
@@ -536,7 +546,6 @@ AHA_TEST(NumberTest, min_setter_p1) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**1)}}\","
             "\"min\":2.5,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -558,7 +567,6 @@ AHA_TEST(NumberTest, min_setter_p2) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**2)}}\","
             "\"min\":95467.50,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -580,7 +588,6 @@ AHA_TEST(NumberTest, min_setter_p3) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**3)}}\","
             "\"min\":50.500,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -623,7 +630,6 @@ AHA_TEST(NumberTest, max_setter_p1) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**1)}}\","
             "\"max\":2.5,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -645,7 +651,6 @@ AHA_TEST(NumberTest, max_setter_p2) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**2)}}\","
             "\"max\":95467.50,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -667,7 +672,6 @@ AHA_TEST(NumberTest, max_setter_p3) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**3)}}\","
             "\"max\":50.500,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -710,7 +714,6 @@ AHA_TEST(NumberTest, step_setter_p1) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**1)}}\","
             "\"step\":2.5,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -732,7 +735,6 @@ AHA_TEST(NumberTest, step_setter_p2) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**2)}}\","
             "\"step\":0.01,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -754,7 +756,6 @@ AHA_TEST(NumberTest, step_setter_p3) {
         (
             "{"
             "\"uniq_id\":\"uniqueNumber\","
-            "\"cmd_tpl\":\"{{int(float(value)*10**3)}}\","
             "\"step\":0.001,"
             "\"dev\":{\"ids\":\"testDevice\"},"
             "\"stat_t\":\"testData/testDevice/uniqueNumber/stat_t\","
@@ -774,6 +775,16 @@ AHA_TEST(NumberTest, command_none) {
     assertCommandCallbackCalled(HANumeric(), &number)
 }
 
+AHA_TEST(NumberTest, command_none_prefix) {
+    prepareTest
+
+    HANumber number(testUniqueId);
+    number.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("N"));
+
+    assertCommandCallbackNotCalled()
+}
+
 AHA_TEST(NumberTest, command_number_zero) {
     prepareTest
 
@@ -810,7 +821,7 @@ AHA_TEST(NumberTest, command_number_float_p1) {
 
     HANumber number(testUniqueId, HANumber::PrecisionP1);
     number.onCommand(onCommandReceived);
-    mock->fakeMessage(AHATOFSTR(CommandTopic), F("-1234"));
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("-123.4"));
 
     assertCommandCallbackCalled(HANumeric(-123.4f, 1), &number)
 }
@@ -820,7 +831,7 @@ AHA_TEST(NumberTest, command_number_float_p2) {
 
     HANumber number(testUniqueId, HANumber::PrecisionP2);
     number.onCommand(onCommandReceived);
-    mock->fakeMessage(AHATOFSTR(CommandTopic), F("-1234"));
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("-12.34"));
 
     assertCommandCallbackCalled(HANumeric(-12.34f, 2), &number)
 }
@@ -830,7 +841,7 @@ AHA_TEST(NumberTest, command_number_float_p3) {
 
     HANumber number(testUniqueId, HANumber::PrecisionP3);
     number.onCommand(onCommandReceived);
-    mock->fakeMessage(AHATOFSTR(CommandTopic), F("-1234"));
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("-1.234"));
 
     assertCommandCallbackCalled(HANumeric(-1.234f, 3), &number)
 }
@@ -18,6 +18,18 @@
     assertEqual(expectedLength, writtenLength); \
 }
 
+#define assertBaseValueToStr(baseValue, precision, expectedStr) \
+{ \
+    memset(tmpBuffer, 0, sizeof(tmpBuffer)); \
+    HANumeric number; \
+    number.setBaseValue(baseValue); \
+    number.setPrecision(precision); \
+    const uint16_t writtenLength = number.toStr(tmpBuffer); \
+    assertEqual(F(expectedStr), tmpBuffer); \
+    assertEqual((uint16_t)strlen(expectedStr), writtenLength); \
+    assertEqual((uint8_t)writtenLength, number.calculateSize()); \
+}
+
 #define assertStrToNumber(expected, str) \
 { \
     HANumeric number = HANumeric::fromStr( \
@@ -37,6 +49,28 @@
     assertFalse(number.isSet()); \
 }
 
+#define assertDecimalStrToNumber(expected, precision, str) \
+{ \
+    HANumeric number = HANumeric::fromStr( \
+        reinterpret_cast<const uint8_t*>(str), \
+        strlen(str), \
+        precision \
+    ); \
+    assertTrue(number.isSet()); \
+    assertEqual((int64_t)expected, number.getBaseValue()); \
+    assertEqual((uint8_t)precision, number.getPrecision()); \
+}
+
+#define assertDecimalStrToNumberInvalid(precision, str) \
+{ \
+    HANumeric number = HANumeric::fromStr( \
+        reinterpret_cast<const uint8_t*>(str), \
+        strlen(str), \
+        precision \
+    ); \
+    assertFalse(number.isSet()); \
+}
+
 using aunit::TestRunner;
 
 char tmpBuffer[32];
@@ -413,6 +447,37 @@ AHA_TEST(NumericTest, number_to_str_float_p3_signed) {
     assertNumberToStr(-5526.12456456f, 3, "-5526.124");
 }
 
+AHA_TEST(NumericTest, number_to_str_int32_limits) {
+    assertBaseValueToStr(INT32_MAX, 0, "2147483647");
+    assertBaseValueToStr(INT32_MIN, 0, "-2147483648");
+    assertBaseValueToStr(UINT32_MAX, 0, "4294967295");
+}
+
+AHA_TEST(NumericTest, number_to_str_int64_p0) {
+    assertBaseValueToStr(4294967296LL, 0, "4294967296");
+    assertBaseValueToStr(1000000000000000000LL, 0, "1000000000000000000");
+    assertBaseValueToStr(-1000000000000000001LL, 0, "-1000000000000000001");
+}
+
+AHA_TEST(NumericTest, number_to_str_int64_limits) {
+    assertBaseValueToStr(INT64_MAX, 0, "9223372036854775807");
+    assertBaseValueToStr(INT64_MIN, 0, "-9223372036854775808");
+    assertBaseValueToStr(INT64_MIN, 3, "-9223372036854775.808");
+}
+
+AHA_TEST(NumericTest, number_to_str_int64_p2) {
+    assertBaseValueToStr(123456789012LL, 2, "1234567890.12");
+    assertBaseValueToStr(-5000000000LL, 2, "-50000000.00");
+}
+
+AHA_TEST(NumericTest, number_to_str_base_value_padding) {
+    assertBaseValueToStr(5, 3, "0.005");
+    assertBaseValueToStr(-5, 3, "-0.005");
+    assertBaseValueToStr(50, 2, "0.50");
+    assertBaseValueToStr(100, 2, "1.00");
+    assertBaseValueToStr(99, 1, "9.9");
+}
+
 AHA_TEST(NumericTest, str_to_number_max) {
     assertStrToNumber(9223372036854775807, "9223372036854775807");
 }
@@ -582,6 +647,72 @@ AHA_TEST(NumericTest, str_to_number_invalid_3) {
     assertStrToNumberInvalid("15.334");
 }
 
+AHA_TEST(NumericTest, str_to_number_decimal_point_rejected) {
+    assertStrToNumberInvalid("21.5");
+}
+
+AHA_TEST(NumericTest, str_to_number_sign_only) {
+    assertStrToNumberInvalid("-");
+}
+
+AHA_TEST(NumericTest, str_to_number_long) {
+    assertStrToNumber(1234567890123LL, "1234567890123");
+    assertStrToNumber(-12345678, "-12345678");
+    assertStrToNumber(123456, "0000123456");
+}
+
+AHA_TEST(NumericTest, str_to_number_long_invalid) {
+    assertStrToNumberInvalid("1234567a");
+    assertStrToNumberInvalid("123456789012:");
+    assertStrToNumberInvalid("12/4");
+}
+
+AHA_TEST(NumericTest, decimal_str_to_number_p0) {
+    assertDecimalStrToNumber(21, 0, "21");
+    assertDecimalStrToNumber(21, 0, "21.9");
+    assertDecimalStrToNumber(-21, 0, "-21.0");
+}
+
+AHA_TEST(NumericTest, decimal_str_to_number_p1) {
+    assertDecimalStrToNumber(215, 1, "21.5");
+    assertDecimalStrToNumber(-215, 1, "-21.5");
+    assertDecimalStrToNumber(210, 1, "21");
+    assertDecimalStrToNumber(5, 1, "0.5");
+    assertDecimalStrToNumber(-5, 1, "-0.5");
+}
+
+AHA_TEST(NumericTest, decimal_str_to_number_p2) {
+    assertDecimalStrToNumber(2150, 2, "21.5");
+    assertDecimalStrToNumber(2159, 2, "21.59");
+    assertDecimalStrToNumber(5, 2, "0.05");
+    assertDecimalStrToNumber(123456789012LL, 2, "1234567890.12");
+}
+
+AHA_TEST(NumericTest, decimal_str_to_number_p3_truncated) {
+    assertDecimalStrToNumber(1234, 3, "1.23456789");
+    assertDecimalStrToNumber(-1234, 3, "-1.2345");
+}
+
+AHA_TEST(NumericTest, decimal_str_to_number_limits) {
+    assertDecimalStrToNumber(INT64_MAX, 0, "9223372036854775807");
+    assertDecimalStrToNumber(INT64_MIN, 0, "-9223372036854775808");
+    assertDecimalStrToNumber(INT64_MAX, 3, "9223372036854775.807");
+    assertDecimalStrToNumberInvalid(3, "9223372036854775.808");
+    assertDecimalStrToNumberInvalid(3, "92233720368547758.0");
+}
+
+AHA_TEST(NumericTest, decimal_str_to_number_invalid) {
+    assertDecimalStrToNumberInvalid(1, "");
+    assertDecimalStrToNumberInvalid(1, "-");
+    assertDecimalStrToNumberInvalid(1, ".5");
+    assertDecimalStrToNumberInvalid(1, "21.");
+    assertDecimalStrToNumberInvalid(1, "21.5.1");
+    assertDecimalStrToNumberInvalid(1, "21.5a");
+    assertDecimalStrToNumberInvalid(1, "2a.5");
+    assertDecimalStrToNumberInvalid(1, "21,5");
+    assertDecimalStrToNumberInvalid(1, "-21.-5");
+}
+
 AHA_TEST(NumericTest, number_to_float_1) {
     assertNear(HANumeric(500, 0).toFloat(), 500.0, 0.01);
 }
@@ -87,12 +87,22 @@ AHA_TEST(SceneTest, command_subscription) {
     prepareTest
 
     HAScene scene(testUniqueId);
+    scene.onCommand(onCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
     assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
 }
 
+AHA_TEST(SceneTest, command_subscription_without_callback) {
+    prepareTest
+
+    HAScene scene(testUniqueId);
+    mqtt.loop();
+
+    assertEqual(0, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(SceneTest, availability) {
     prepareTest
 
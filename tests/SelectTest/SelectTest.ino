@@ -162,12 +162,23 @@ AHA_TEST(SelectTest, command_subscription) {
 
     HASelect select(testUniqueId);
     select.setOptions("Option A;B;C");
+    select.onCommand(onCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
     assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
 }
 
+AHA_TEST(SelectTest, command_subscription_without_callback) {
+    prepareTest
+
+    HASelect select(testUniqueId);
+    select.setOptions("Option A;B;C");
+    mqtt.loop();
+
+    assertEqual(0, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(SelectTest, availability) {
     prepareTest
 
@@ -458,6 +469,99 @@ AHA_TEST(SelectTest, command_option_non_existing) {
     assertCommandCallbackNotCalled()
 }
 
+AHA_TEST(SelectTest, command_option_prefix) {
+    prepareTest
+
+    HASelect select(testUniqueId);
+    select.setOptions("Option A;B;C");
+    select.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("Option"));
+
+    assertCommandCallbackNotCalled()
+}
+
+AHA_TEST(SelectTest, command_option_longer) {
+    prepareTest
+
+    HASelect select(testUniqueId);
+    select.setOptions("Option A;B;C");
+    select.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("Option AB"));
+
+    assertCommandCallbackNotCalled()
+}
+
+AHA_TEST(SelectTest, command_option_empty) {
+    prepareTest
+
+    HASelect select(testUniqueId);
+    select.setOptions("Option A;B;C");
+    select.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F(""));
+
+    assertCommandCallbackNotCalled()
+}
+
+AHA_TEST(SelectTest, command_option_duplicated) {
+    prepareTest
+
+    HASelect select(testUniqueId);
+    select.setOptions("A;B;A");
+    select.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("A"));
+
+    assertCommandCallbackCalled(0, &select)
+}
+
+AHA_TEST(SelectTest, command_option_trailing_separator) {
+    prepareTest
+
+    HASelect select(testUniqueId);
+    select.setOptions("Low;High;");
+    select.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("High"));
+
+    assertCommandCallbackCalled(1, &select)
+}
+
+AHA_TEST(SelectTest, command_option_empty_option) {
+    prepareTest
+
+    HASelect select(testUniqueId);
+    select.setOptions("x;;y");
+    select.onCommand(onCommandReceived);
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("x"));
+
+    assertCommandCallbackCalled(0, &select)
+}
+
+AHA_TEST(SelectTest, command_option_many_options) {
+    prepareTest
+
+    char options[512] = {0};
+    for (uint8_t i = 0; i < 100; i++) {
+        sprintf(&options[strlen(options)], i == 0 ? "P%u" : ";P%u", i);
+    }
+
+    HASelect select(testUniqueId);
+    select.setOptions(options);
+    select.onCommand(onCommandReceived);
+
+    assertEqual((uint8_t)100, select.getOptions()->getItemsNb());
+    assertEqual("P99", select.getOptions()->getItem(99));
+
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("P99"));
+    assertCommandCallbackCalled(99, &select)
+
+    lastCommandCallbackCall.reset();
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("P1"));
+    assertCommandCallbackCalled(1, &select)
+
+    lastCommandCallbackCall.reset();
+    mock->fakeMessage(AHATOFSTR(CommandTopic), F("P100"));
+    assertCommandCallbackNotCalled()
+}
+
 AHA_TEST(SelectTest, different_select_command) {
     prepareTest
 
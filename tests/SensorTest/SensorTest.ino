@@ -19,6 +19,18 @@ AHA_TEST(SensorTest, invalid_unique_id) {
     assertTrue(serializer == nullptr);
 }
 
+AHA_TEST(SensorTest, schema_serializer) {
+    initMqttTest(testDeviceId)
+
+    HASensor sensor(testUniqueId);
+    sensor.buildSerializerTest();
+    HASerializer* serializer = sensor.getSerializer();
+
+    assertTrue(serializer != nullptr);
+    assertTrue(serializer->getEntries() == nullptr);
+    assertEqual((uint8_t)13, serializer->getEntriesNb());
+}
+
 AHA_TEST(SensorTest, default_params) {
     initMqttTest(testDeviceId)
 
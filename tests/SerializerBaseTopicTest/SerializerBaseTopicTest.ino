@@ -0,0 +1,138 @@
+#include <AUnit.h>
+#include <ArduinoHA.h>
+
+using aunit::TestRunner;
+
+static const char* testDeviceId = "testDevice";
+
+const char SensorConfigTopic[] PROGMEM = {"homeassistant/sensor/testDevice/uniqueSensor/config"};
+const char SwitchConfigTopic[] PROGMEM = {"homeassistant/switch/testDevice/uniqueSwitch/config"};
+
+AHA_TEST(SerializerBaseTopicTest, single_topic) {
+    initMqttTest(testDeviceId)
+
+    HASensor sensor("uniqueSensor");
+    assertEntityConfigOnTopic(
+        mock,
+        sensor,
+        AHATOFSTR(SensorConfigTopic),
+        (
+            "{"
+            "\"uniq_id\":\"uniqueSensor\","
+            "\"dev\":{\"ids\":\"testDevice\"},"
+            "\"stat_t\":\"testData/testDevice/uniqueSensor/stat_t\""
+            "}"
+        )
+    )
+}
+
+AHA_TEST(SerializerBaseTopicTest, multiple_topics) {
+    initMqttTest(testDeviceId)
+
+    HASwitch testSwitch("uniqueSwitch");
+    assertEntityConfigOnTopic(
+        mock,
+        testSwitch,
+        AHATOFSTR(SwitchConfigTopic),
+        (
+            "{"
+            "\"~\":\"testData/testDevice/uniqueSwitch\","
+            "\"uniq_id\":\"uniqueSwitch\","
+            "\"dev\":{\"ids\":\"testDevice\"},"
+            "\"stat_t\":\"~/stat_t\","
+            "\"cmd_t\":\"~/cmd_t\""
+            "}"
+        )
+    )
+}
+
+AHA_TEST(SerializerBaseTopicTest, multiple_topics_with_cache) {
+    initMqttTest(testDeviceId)
+
+    HASwitch testSwitch("uniqueSwitch");
+    mqtt.setTopicsCacheMode(HAMqtt::TopicsCacheFull);
+    mqtt.disconnect();
+    mqtt.begin("testHost", "testUser", "testPass");
+
+    assertEntityConfigOnTopic(
+        mock,
+        testSwitch,
+        AHATOFSTR(SwitchConfigTopic),
+        (
+            "{"
+            "\"~\":\"testData/testDevice/uniqueSwitch\","
+            "\"uniq_id\":\"uniqueSwitch\","
+            "\"dev\":{\"ids\":\"testDevice\"},"
+            "\"stat_t\":\"~/stat_t\","
+            "\"cmd_t\":\"~/cmd_t\""
+            "}"
+        )
+    )
+}
+
+AHA_TEST(SerializerBaseTopicTest, shared_availability) {
+    initMqttTest(testDeviceId)
+
+    device.enableSharedAvailability();
+    HASwitch testSwitch("uniqueSwitch");
+    mqtt.loop();
+
+    // the first message is the device's availability
+    assertMqttMessage(
+        1,
+        AHATOFSTR(SwitchConfigTopic),
+        (
+            "{"
+            "\"~\":\"testData/testDevice/uniqueSwitch\","
+            "\"uniq_id\":\"uniqueSwitch\","
+            "\"dev\":{\"ids\":\"testDevice\"},"
+            "\"avty_t\":\"testData/testDevice/avty_t\","
+            "\"stat_t\":\"~/stat_t\","
+            "\"cmd_t\":\"~/cmd_t\""
+            "}"
+        ),
+        true
+    )
+}
+
+AHA_TEST(SerializerBaseTopicTest, device_discovery) {
+    initMqttTest(testDeviceId)
+    mqtt.enableDeviceDiscovery();
+
+    HASwitch testSwitch("uniqueSwitch");
+    mqtt.loop();
+
+    assertMqttMessage(
+        0,
+        "homeassistant/device/testDevice/config",
+        (
+            "{"
+            "\"dev\":{\"ids\":\"testDevice\"},"
+            "\"o\":{\"name\":\"ArduinoHA\"},"
+            "\"cmps\":{"
+            "\"uniqueSwitch\":{"
+            "\"p\":\"switch\","
+            "\"~\":\"testData/testDevice/uniqueSwitch\","
+            "\"uniq_id\":\"uniqueSwitch\","
+            "\"stat_t\":\"~/stat_t\","
+            "\"cmd_t\":\"~/cmd_t\""
+            "}"
+            "}"
+            "}"
+        ),
+        true
+    )
+}
+
+void setup()
+{
+    delay(1000);
+    Serial.begin(115200);
+    while (!Serial);
+}
+
+void loop()
+{
+    TestRunner::run();
+    delay(1);
+}
@@ -20,6 +20,8 @@ using aunit::TestRunner;
 static const char* testDeviceId = "testDevice";
 static const char* testTopic = "testTopic";
 const char TestComponentStr[] PROGMEM = {"dummyProgmem"};
+const char CustomProperty[] PROGMEM = {"custom"};
+const char CustomTopic[] PROGMEM = {"custom_t"};
 
 class DummyDeviceType : public HABaseDeviceType
 {
@@ -55,6 +57,80 @@ AHA_TEST(SerializerTest, char_field) {
     assertSerializerMqttMessage("{\"name\":\"XYZ\"}")
 }
 
+AHA_TEST(SerializerTest, entries_limit) {
+    prepareTest(1)
+
+    serializer.set(AHATOFSTR(HANameProperty), "XYZ");
+    serializer.set(AHATOFSTR(HAIconProperty), "Icon");
+    serializer.topic(AHATOFSTR(HAStateTopic));
+
+    assertEqual((uint8_t)1, serializer.getEntriesNb());
+    flushSerializer(mock, serializer)
+    assertSerializerMqttMessage("{\"name\":\"XYZ\"}")
+}
+
+AHA_TEST(SerializerTest, custom_property) {
+    prepareTest(3)
+
+    serializer.set(AHATOFSTR(CustomProperty), "XYZ");
+    serializer.set(AHATOFSTR(HAIconProperty), "Icon");
+
+    assertEqual((uint8_t)3, serializer.getEntriesNb());
+    flushSerializer(mock, serializer)
+    assertSerializerMqttMessage("{\"custom\":\"XYZ\",\"ic\":\"Icon\"}")
+}
+
+AHA_TEST(SerializerTest, custom_property_flash_literal) {
+    prepareTest(2)
+
+    serializer.set(F("literal"), "XYZ");
+
+    flushSerializer(mock, serializer)
+    assertSerializerMqttMessage("{\"literal\":\"XYZ\"}")
+}
+
+AHA_TEST(SerializerTest, custom_property_updated) {
+    prepareTest(2)
+
+    serializer.update(AHATOFSTR(CustomProperty), "XYZ");
+    serializer.update(AHATOFSTR(CustomProperty), "ABC");
+
+    assertEqual((uint8_t)2, serializer.getEntriesNb());
+    flushSerializer(mock, serializer)
+    assertSerializerMqttMessage("{\"custom\":\"ABC\"}")
+}
+
+AHA_TEST(SerializerTest, custom_property_entries_limit) {
+    prepareTest(2)
+
+    serializer.set(AHATOFSTR(HANameProperty), "XYZ");
+    serializer.set(AHATOFSTR(CustomProperty), "ABC");
+
+    assertEqual((uint8_t)1, serializer.getEntriesNb());
+    flushSerializer(mock, serializer)
+    assertSerializerMqttMessage("{\"name\":\"XYZ\"}")
+}
+
+AHA_TEST(SerializerTest, char_field_appended) {
+    prepareTest(2)
+
+    serializer.set(AHATOFSTR(HANameProperty), "XYZ");
+    serializer.set(AHATOFSTR(HANameProperty), "ABC");
+
+    assertEqual((uint8_t)2, serializer.getEntriesNb());
+}
+
+AHA_TEST(SerializerTest, char_field_updated) {
+    prepareTest(2)
+
+    serializer.update(AHATOFSTR(HANameProperty), "XYZ");
+    serializer.update(AHATOFSTR(HANameProperty), "ABC");
+
+    assertEqual((uint8_t)1, serializer.getEntriesNb());
+    flushSerializer(mock, serializer)
+    assertSerializerMqttMessage("{\"name\":\"ABC\"}")
+}
+
 AHA_TEST(SerializerTest, bool_false_field) {
     prepareTest(1)
 
@@ -219,6 +295,17 @@ AHA_TEST(SerializerTest, topic_field) {
     )
 }
 
+AHA_TEST(SerializerTest, custom_topic_field) {
+    prepareTest(2)
+
+    serializer.topic(AHATOFSTR(CustomTopic));
+
+    flushSerializer(mock, serializer)
+    assertSerializerMqttMessage(
+        "{\"custom_t\":\"testData/testDevice/testId/custom_t\"}"
+    )
+}
+
 AHA_TEST(SerializerTest, topics_field) {
     prepareTest(2)
 
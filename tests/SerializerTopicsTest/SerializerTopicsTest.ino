@@ -342,6 +342,99 @@ AHA_TEST(SerializerTopicsTest, compare_not_matching_topics) {
     ));
 }
 
+AHA_TEST(SerializerTopicsTest, compare_partial_topics) {
+    const char* topic = "dataPrefix/testDevice/dummyProgmem";
+
+    HADevice device(deviceId);
+    HAMqtt mqtt(nullptr, device);
+    mqtt.setDataPrefix(dataPrefix);
+
+    assertTrue(HASerializer::compareDataTopics(
+        topic,
+        nullptr,
+        AHATOFSTR(DummyProgmemStr)
+    ));
+}
+
+AHA_TEST(SerializerTopicsTest, compare_topics_different_length) {
+    HADevice device(deviceId);
+    HAMqtt mqtt(nullptr, device);
+    mqtt.setDataPrefix(dataPrefix);
+
+    assertFalse(HASerializer::compareDataTopics(
+        "dataPrefix/testDevice/objectId/dummyProgmemSuffix",
+        "objectId",
+        AHATOFSTR(DummyProgmemStr)
+    ));
+    assertFalse(HASerializer::compareDataTopics(
+        "dataPrefix/testDevice/objectId/dummy",
+        "objectId",
+        AHATOFSTR(DummyProgmemStr)
+    ));
+    assertFalse(HASerializer::compareDataTopics(
+        "dataPrefix/testDevice",
+        "objectId",
+        AHATOFSTR(DummyProgmemStr)
+    ));
+}
+
+AHA_TEST(SerializerTopicsTest, split_data_topic) {
+    const char* topic = "dataPrefix/testDevice/objectId/dummyProgmem";
+    const char* objectId = nullptr;
+    const char* objectTopic = nullptr;
+    uint16_t objectIdLength = 0;
+
+    HADevice device(deviceId);
+    HAMqtt mqtt(nullptr, device);
+    mqtt.setDataPrefix(dataPrefix);
+
+    assertTrue(HASerializer::splitDataTopic(
+        topic,
+        &objectId,
+        &objectIdLength,
+        &objectTopic
+    ));
+    assertEqual((uint16_t)8, objectIdLength);
+    assertTrue(memcmp(objectId, "objectId", objectIdLength) == 0);
+    assertEqual("dummyProgmem", objectTopic);
+}
+
+AHA_TEST(SerializerTopicsTest, split_data_topic_other_device) {
+    const char* topic = "dataPrefix/otherDevice/objectId/dummyProgmem";
+    const char* objectId = nullptr;
+    const char* objectTopic = nullptr;
+    uint16_t objectIdLength = 0;
+
+    HADevice device(deviceId);
+    HAMqtt mqtt(nullptr, device);
+    mqtt.setDataPrefix(dataPrefix);
+
+    assertFalse(HASerializer::splitDataTopic(
+        topic,
+        &objectId,
+        &objectIdLength,
+        &objectTopic
+    ));
+}
+
+AHA_TEST(SerializerTopicsTest, split_data_topic_device_level) {
+    const char* topic = "dataPrefix/testDevice/avty_t";
+    const char* objectId = nullptr;
+    const char* objectTopic = nullptr;
+    uint16_t objectIdLength = 0;
+
+    HADevice device(deviceId);
+    HAMqtt mqtt(nullptr, device);
+    mqtt.setDataPrefix(dataPrefix);
+
+    assertFalse(HASerializer::splitDataTopic(
+        topic,
+        &objectId,
+        &objectIdLength,
+        &objectTopic
+    ));
+}
+
 void setup()
 {
     delay(1000);
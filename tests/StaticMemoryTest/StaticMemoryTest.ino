@@ -0,0 +1,130 @@
+#include <AUnit.h>
+#include <ArduinoHA.h>
+
+#define initStaticMqttTest(devicesTypesNb) \
+    PubSubClientMock* mock = new PubSubClientMock(); \
+    HADevice device(testDeviceId); \
+    HAMqttStatic<devicesTypesNb> mqtt(mock, device); \
+    mqtt.setDataPrefix("testData");
+
+#define assertNoAllocations() \
+{ \
+    for (uint8_t i = 0; i < HAMqtt::OperationsNb; i++) { \
+        const HAMqtt::Operation operation = static_cast<HAMqtt::Operation>(i); \
+        assertEqual((uint32_t)0, mqtt.getAllocationStats(operation).allocationsNb); \
+    } \
+}
+
+using aunit::TestRunner;
+
+static const char* testDeviceId = "testDevice";
+
+const char SensorConfigTopic[] PROGMEM = {"homeassistant/sensor/testDevice/uniqueSensor/config"};
+
+AHA_TEST(StaticMemoryTest, no_allocations_on_connect) {
+    initStaticMqttTest(4)
+
+    device.setName("Test device");
+    HASensor sensor("uniqueSensor");
+    HASwitch lightSwitch("uniqueSwitch");
+    HAHVAC hvac(
+        "uniqueHvac",
+        HAHVAC::ActionFeature | HAHVAC::AuxHeatingFeature | HAHVAC::PowerFeature |
+        HAHVAC::FanFeature | HAHVAC::SwingFeature | HAHVAC::ModesFeature |
+        HAHVAC::TargetTemperatureFeature
+    );
+    HALight light("uniqueLight", HALight::BrightnessFeature | HALight::RGBFeature);
+
+    mqtt.resetAllocationStats();
+    const uint32_t heapBytes = mqtt.getHeapBytes();
+
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+
+    assertNoAllocations()
+    assertEqual(heapBytes, mqtt.getHeapBytes());
+    assertMoreOrEqual(mock->getFlushedMessagesNb(), (uint8_t)4);
+}
+
+AHA_TEST(StaticMemoryTest, no_allocations_on_publish) {
+    initStaticMqttTest(2)
+
+    HASensor sensor("uniqueSensor");
+    HASwitch lightSwitch("uniqueSwitch");
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+
+    mqtt.resetAllocationStats();
+    const uint32_t heapBytes = mqtt.getHeapBytes();
+
+    sensor.setValue("value");
+    lightSwitch.setState(true);
+    mock->fakeMessage("testData/testDevice/uniqueSwitch/cmd_t", "OFF");
+
+    mock->clearFlushedMessages();
+    mock->clearSubscriptions();
+    mqtt.disconnect();
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+
+    assertNoAllocations()
+    assertEqual(heapBytes, mqtt.getHeapBytes());
+}
+
+AHA_TEST(StaticMemoryTest, config_with_static_serializers) {
+    initStaticMqttTest(1)
+
+    device.setManufacturer("testManufacturer");
+    HASensor sensor("uniqueSensor");
+    mqtt.begin("testHost", "testUser", "testPass");
+    mqtt.loop();
+
+    assertMqttMessage(
+        0,
+        AHATOFSTR(SensorConfigTopic),
+        (
+            "{"
+            "\"uniq_id\":\"uniqueSensor\","
+            "\"dev\":{\"ids\":\"testDevice\",\"mf\":\"testManufacturer\"},"
+            "\"stat_t\":\"testData/testDevice/uniqueSensor/stat_t\""
+            "}"
+        ),
+        true
+    )
+}
+
+AHA_TEST(StaticMemoryTest, devices_types_limit) {
+    initStaticMqttTest(2)
+
+    HASensor sensorA("uniqueSensorA");
+    HASensor sensorB("uniqueSensorB");
+    HASensor sensorC("uniqueSensorC");
+
+    assertEqual((uint8_t)2, mqtt.getDevicesTypesNb());
+}
+
+AHA_TEST(StaticMemoryTest, shared_serializer_in_use) {
+    initStaticMqttTest(2)
+
+    HASwitch switchA("uniqueSwitchA");
+    HASwitch switchB("uniqueSwitchB");
+
+    switchA.buildSerializerTest();
+    switchB.buildSerializerTest();
+
+    assertTrue(switchA.getSerializer() != nullptr);
+    assertTrue(switchB.getSerializer() == nullptr);
+}
+
+void setup()
+{
+    delay(1000);
+    Serial.begin(115200);
+    while (!Serial);
+}
+
+void loop()
+{
+    TestRunner::run();
+    delay(1);
+}
@@ -95,12 +95,38 @@ AHA_TEST(SwitchTest, command_subscription) {
     prepareTest
 
     HASwitch testSwitch(testUniqueId);
+    testSwitch.onCommand(onCommandReceived);
     mqtt.loop();
 
     assertEqual(1, mock->getSubscriptionsNb());
     assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
 }
 
+AHA_TEST(SwitchTest, command_subscription_without_callback) {
+    prepareTest
+
+    HASwitch testSwitch(testUniqueId);
+    mqtt.loop();
+
+    assertEqual(0, mock->getSubscriptionsNb());
+}
+
+AHA_TEST(SwitchTest, command_subscription_runtime) {
+    prepareTest
+
+    HASwitch testSwitch(testUniqueId);
+    mqtt.loop();
+    assertEqual(0, mock->getSubscriptionsNb());
+
+    testSwitch.onCommand(onCommandReceived);
+    assertEqual(1, mock->getSubscriptionsNb());
+    assertEqual(AHATOFSTR(CommandTopic), mock->getSubscriptions()[0]->topic);
+
+    // the topic is already subscribed
+    testSwitch.onCommand(onCommandReceived);
+    assertEqual(1, mock->getSubscriptionsNb());
+}
+
 AHA_TEST(SwitchTest, availability) {
     prepareTest
 
@@ -39,6 +39,39 @@ AHA_TEST(UtilsTest, ends_with_invalid_4) {
     assertFalse(HAUtils::endsWith("test", "testtest"));
 }
 
+AHA_TEST(UtilsTest, keywords_equals) {
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>("auto");
+
+    assertTrue(HAKeywords::equals(HAModeAuto, payload, 4));
+    assertFalse(HAKeywords::equals(HAModeAuto, payload, 2));
+    assertFalse(HAKeywords::equals(HAModeAuto, payload, 0));
+    assertFalse(HAKeywords::equals(HAModeOff, payload, 4));
+}
+
+AHA_TEST(UtilsTest, keywords_equals_longer_payload) {
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>("offline");
+    assertFalse(HAKeywords::equals(HAModeOff, payload, 7));
+}
+
+AHA_TEST(UtilsTest, keywords_decode_encode) {
+    static const HAKeyword keywords[] PROGMEM = {
+        {HAModeOff, 2},
+        {HAModeFanOnly, 5},
+        {HAFanModeMedium, 7}
+    };
+
+    uint8_t value = 0;
+    const uint8_t* payload = reinterpret_cast<const uint8_t*>("fan_only");
+
+    assertTrue(HAKeywords::decode(keywords, HAKEYWORDS_NB(keywords), payload, 8, value));
+    assertEqual((uint8_t)5, value);
+    assertFalse(HAKeywords::decode(keywords, HAKEYWORDS_NB(keywords), payload, 3, value));
+    assertFalse(HAKeywords::decode(keywords, HAKEYWORDS_NB(keywords), payload, 0, value));
+
+    assertEqual(AHATOFSTR(HAFanModeMedium), HAKeywords::encode(keywords, HAKEYWORDS_NB(keywords), 7));
+    assertTrue(HAKeywords::encode(keywords, HAKEYWORDS_NB(keywords), 3) == nullptr);
+}
+
 void setup()
 {
     delay(1000);